@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Benchmark.h>
+#include <Core/Jobs/JobSystem.h>
+#include <cstdio>
+
+namespace CaveGame
+{
+
+// NOTE: The pointers are constant-initialized, so they are valid before any registration is constructed.
+static BenchmarkRegistration* s_first_registration = nullptr;
+static BenchmarkRegistration* s_last_registration = nullptr;
+
+static u32 s_repetition_count = 5;
+
+BenchmarkRegistration::BenchmarkRegistration(const char* in_name, BenchmarkFunction in_function)
+    : name(in_name)
+    , function(in_function)
+    , next(nullptr)
+{
+    if (s_last_registration)
+        s_last_registration->next = this;
+    else
+        s_first_registration = this;
+    s_last_registration = this;
+}
+
+void Detail::escape_pointer(MAYBE_UNUSED const volatile void* pointer)
+{}
+
+void Benchmark::begin_group(const char* group_name)
+{
+    std::printf("\n%s\n", group_name);
+    std::printf("  %-48s %12s %12s %14s %10s\n", "case", "time (ms)", "ns/item", "Mitems/s", "GB/s");
+}
+
+void Benchmark::report(const char* case_name, u64 item_count, u64 byte_count, u64 elapsed_ticks)
+{
+    const double elapsed_seconds = static_cast<double>(elapsed_ticks) / static_cast<double>(PlatformCore::get_tick_counter_frequency());
+    const double nanoseconds_per_item = (item_count > 0) ? (elapsed_seconds * 1e9) / static_cast<double>(item_count) : 0.0;
+    const double million_items_per_second = (elapsed_seconds > 0.0) ? static_cast<double>(item_count) / (elapsed_seconds * 1e6) : 0.0;
+
+    if (byte_count > 0)
+    {
+        const double gigabytes_per_second = (elapsed_seconds > 0.0) ? static_cast<double>(byte_count) / (elapsed_seconds * 1e9) : 0.0;
+        std::printf("  %-48s %12.3f %12.2f %14.2f %10.2f\n", case_name, elapsed_seconds * 1e3, nanoseconds_per_item, million_items_per_second, gigabytes_per_second);
+    }
+    else
+    {
+        std::printf("  %-48s %12.3f %12.2f %14.2f %10s\n", case_name, elapsed_seconds * 1e3, nanoseconds_per_item, million_items_per_second, "-");
+    }
+}
+
+void Benchmark::report_speedup(const char* case_name, u64 baseline_elapsed_ticks, u64 elapsed_ticks)
+{
+    const double speedup = (elapsed_ticks > 0) ? static_cast<double>(baseline_elapsed_ticks) / static_cast<double>(elapsed_ticks) : 0.0;
+    std::printf("  %-48s %11.2fx\n", case_name, speedup);
+}
+
+void Benchmark::restart_job_system(u32 worker_thread_count)
+{
+    JobSystem::shutdown();
+    MAYBE_UNUSED const bool is_initialized = JobSystem::initialize(worker_thread_count);
+    CAVE_ASSERT(is_initialized);
+}
+
+u32 Benchmark::get_repetition_count()
+{
+    return s_repetition_count;
+}
+
+void Benchmark::set_repetition_count(u32 repetition_count)
+{
+    s_repetition_count = (repetition_count > 0) ? repetition_count : 1;
+}
+
+BenchmarkRegistration* Benchmark::get_first_registration()
+{
+    return s_first_registration;
+}
+
+} // namespace CaveGame
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+#include <Core/Platform/PlatformCore.h>
+
+namespace CaveGame
+{
+
+using BenchmarkFunction = void (*)();
+
+//
+// Registers a benchmark in the global list of benchmarks, which are executed by the benchmark runner in registration
+// order. Instances are only created by the `CAVE_BENCHMARK` macro, as static variables.
+//
+struct BenchmarkRegistration
+{
+    BenchmarkRegistration(const char* in_name, BenchmarkFunction in_function);
+
+    const char* name;
+    BenchmarkFunction function;
+    BenchmarkRegistration* next;
+};
+
+//
+// Defines and registers a benchmark. The benchmark is executed if its name contains the filter passed on the command
+// line. A benchmark usually measures multiple cases (for example, different sizes or thread counts) by invoking
+// `Benchmark::measure` once for each case.
+//
+#define CAVE_BENCHMARK(benchmark_name)                                                                \
+    static void benchmark_name();                                                                     \
+    static ::CaveGame::BenchmarkRegistration s_##benchmark_name##_registration(#benchmark_name, benchmark_name); \
+    static void benchmark_name()
+
+namespace Detail
+{
+
+// Defined in a separate translation unit, so the compiler can't assume that the pointed memory is never read.
+void escape_pointer(const volatile void* pointer);
+
+} // namespace Detail
+
+class Benchmark
+{
+public:
+    //
+    // Prevents the compiler from optimizing away the computation of the given value, or the stores to the memory it
+    // refers to, without adding any instruction to the measured code.
+    //
+    template<typename T>
+    ALWAYS_INLINE static void do_not_optimize(const T& value)
+    {
+#if CAVE_COMPILER_CLANG || CAVE_COMPILER_GCC
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        Detail::escape_pointer(&value);
+#endif // CAVE_COMPILER_CLANG || CAVE_COMPILER_GCC
+    }
+
+    //
+    // Executes the function `get_repetition_count()` times and reports the fastest execution. The item count is the
+    // number of operations executed by the function (for example, the number of inserted elements), while the byte
+    // count is the amount of memory processed by the function, or zero if the throughput isn't relevant.
+    // Returns the number of ticks of the fastest execution, which allows the benchmark to compare the cases.
+    //
+    template<typename Function>
+    static u64 measure(const char* case_name, u64 item_count, u64 byte_count, Function function)
+    {
+        u64 best_elapsed_ticks = static_cast<u64>(-1);
+        for (u32 repetition_index = 0; repetition_index < get_repetition_count(); ++repetition_index)
+        {
+            const u64 begin_tick = PlatformCore::get_current_tick_counter();
+            function();
+            const u64 elapsed_ticks = PlatformCore::get_current_tick_counter() - begin_tick;
+
+            if (elapsed_ticks < best_elapsed_ticks)
+                best_elapsed_ticks = elapsed_ticks;
+        }
+
+        report(case_name, item_count, byte_count, best_elapsed_ticks);
+        return best_elapsed_ticks;
+    }
+
+    // Prints the header of a group of related cases, such as the cases that compare two implementations.
+    static void begin_group(const char* group_name);
+
+    // Prints a single result line. Used directly by the benchmarks that measure the time themselves.
+    static void report(const char* case_name, u64 item_count, u64 byte_count, u64 elapsed_ticks);
+
+    // Prints the speedup of a case relative to the baseline case of the group, given the ticks returned by `measure`.
+    static void report_speedup(const char* case_name, u64 baseline_elapsed_ticks, u64 elapsed_ticks);
+
+    //
+    // Shuts down the job system and initializes it again with the given number of worker threads, which allows the
+    // benchmarks to measure how the jobs scale with the thread count. Zero selects the default thread count.
+    //
+    static void restart_job_system(u32 worker_thread_count);
+
+public:
+    NODISCARD static u32 get_repetition_count();
+    static void set_repetition_count(u32 repetition_count);
+
+    // Returns the first registered benchmark. The others are linked through `BenchmarkRegistration::next`.
+    NODISCARD static BenchmarkRegistration* get_first_registration();
+};
+
+} // namespace CaveGame
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Benchmark.h>
+#include <Engine/Engine.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace CaveGame
+{
+
+//
+// Returns the value of the command line argument if it starts with the provided prefix, or nullptr otherwise.
+// For example, matching `-repetitions=10` against `-repetitions=` returns `10`.
+//
+static const char* match_command_line_argument(const char* argument, const char* prefix)
+{
+    const usize prefix_length = std::strlen(prefix);
+    if (std::strncmp(argument, prefix, prefix_length) != 0)
+        return nullptr;
+    return argument + prefix_length;
+}
+
+//
+// Supported command line arguments:
+//   -filter=<text>         Only executes the benchmarks whose name contains the given text.
+//   -repetitions=<count>   Executes each case the given number of times and reports the fastest execution.
+//   -list                  Prints the names of the registered benchmarks, without executing them.
+//
+static int benchmarks_main(int argument_count, char** arguments)
+{
+    const char* filter = nullptr;
+    bool list_only = false;
+
+    for (int argument_index = 1; argument_index < argument_count; ++argument_index)
+    {
+        const char* argument = arguments[argument_index];
+        const char* value = nullptr;
+
+        if (std::strcmp(argument, "-list") == 0)
+            list_only = true;
+        else if ((value = match_command_line_argument(argument, "-filter=")))
+            filter = value;
+        else if ((value = match_command_line_argument(argument, "-repetitions=")))
+            Benchmark::set_repetition_count(static_cast<u32>(std::strtoul(value, nullptr, 10)));
+    }
+
+    if (!initialize_core_systems())
+    {
+        // Core systems initialization failed. Aborting.
+        return 1;
+    }
+
+    for (BenchmarkRegistration* registration = Benchmark::get_first_registration(); registration; registration = registration->next)
+    {
+        if (filter && !std::strstr(registration->name, filter))
+            continue;
+
+        if (list_only)
+        {
+            std::printf("%s\n", registration->name);
+            continue;
+        }
+
+        std::printf("\n==== %s ====\n", registration->name);
+        registration->function();
+        std::fflush(stdout);
+    }
+
+    shutdown_core_systems();
+    return 0;
+}
+
+} // namespace CaveGame
+
+int main(int argument_count, char** arguments)
+{
+    const int return_code = CaveGame::benchmarks_main(argument_count, arguments);
+    return return_code;
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Benchmark.h>
+#include <Core/Containers/HashMap.h>
+#include <Core/Containers/String.h>
+#include <Core/Containers/Vector.h>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CaveGame
+{
+
+static constexpr usize hash_map_benchmark_sizes[] = { 1024, 64 * 1024, 1024 * 1024 };
+
+// Each case executes at least this many operations, by repeating the operations on maps with fewer elements.
+static constexpr u64 hash_map_benchmark_min_operation_count = 4 * 1024 * 1024;
+
+// Generates well distributed 64-bit keys (splitmix64), such that no key is generated twice for different indices.
+NODISCARD static u64 generate_integer_key(u64 index)
+{
+    u64 value = index + 0x9E3779B97F4A7C15;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+    return value ^ (value >> 31);
+}
+
+//
+// Measures the insertion, the successful lookup and the failed lookup of `element_count` keys, for both the engine map
+// and the standard map. The first `element_count` keys are inserted and the following `element_count` keys are used
+// for the failed lookups. The keys are looked up in a different order than the one they were inserted in.
+//
+template<typename EngineMapType, typename StandardMapType, typename EngineKeyArray, typename StandardKeyArray>
+static void measure_hash_map(const char* key_type_name, usize element_count, const EngineKeyArray& engine_keys, const StandardKeyArray& standard_keys)
+{
+    const u64 round_count = (hash_map_benchmark_min_operation_count + element_count - 1) / element_count;
+    const u64 operation_count = round_count * element_count;
+    char case_name[96];
+
+    // Insertion, starting from an empty map. The destruction of the map is also measured.
+    std::snprintf(case_name, sizeof(case_name), "std::unordered_map insert, %s, %zu", key_type_name, element_count);
+    const u64 standard_insert_ticks = Benchmark::measure(case_name, operation_count, 0, [&]() {
+        for (u64 round_index = 0; round_index < round_count; ++round_index)
+        {
+            StandardMapType map;
+            for (usize index = 0; index < element_count; ++index)
+                map.emplace(standard_keys[index], index);
+            Benchmark::do_not_optimize(map);
+        }
+    });
+
+    std::snprintf(case_name, sizeof(case_name), "HashMap insert, %s, %zu", key_type_name, element_count);
+    const u64 engine_insert_ticks = Benchmark::measure(case_name, operation_count, 0, [&]() {
+        for (u64 round_index = 0; round_index < round_count; ++round_index)
+        {
+            EngineMapType map;
+            for (usize index = 0; index < element_count; ++index)
+                map.set(engine_keys[index], index);
+            Benchmark::do_not_optimize(map);
+        }
+    });
+    Benchmark::report_speedup("insert speedup", standard_insert_ticks, engine_insert_ticks);
+
+    StandardMapType standard_map;
+    EngineMapType engine_map;
+    for (usize index = 0; index < element_count; ++index)
+    {
+        standard_map.emplace(standard_keys[index], index);
+        engine_map.set(engine_keys[index], index);
+    }
+
+    // NOTE: The stride is odd and the element count is a power of two, so every key is visited once per round.
+    const usize lookup_stride = 7919;
+
+    // Successful lookups.
+    std::snprintf(case_name, sizeof(case_name), "std::unordered_map lookup hit, %s, %zu", key_type_name, element_count);
+    const u64 standard_hit_ticks = Benchmark::measure(case_name, operation_count, 0, [&]() {
+        usize sum = 0;
+        for (u64 round_index = 0; round_index < round_count; ++round_index)
+        {
+            usize index = 0;
+            for (usize lookup_index = 0; lookup_index < element_count; ++lookup_index)
+            {
+                sum += standard_map.find(standard_keys[index])->second;
+                index = (index + lookup_stride) & (element_count - 1);
+            }
+        }
+        Benchmark::do_not_optimize(sum);
+    });
+
+    std::snprintf(case_name, sizeof(case_name), "HashMap lookup hit, %s, %zu", key_type_name, element_count);
+    const u64 engine_hit_ticks = Benchmark::measure(case_name, operation_count, 0, [&]() {
+        usize sum = 0;
+        for (u64 round_index = 0; round_index < round_count; ++round_index)
+        {
+            usize index = 0;
+            for (usize lookup_index = 0; lookup_index < element_count; ++lookup_index)
+            {
+                sum += *engine_map.find(engine_keys[index]);
+                index = (index + lookup_stride) & (element_count - 1);
+            }
+        }
+        Benchmark::do_not_optimize(sum);
+    });
+    Benchmark::report_speedup("lookup hit speedup", standard_hit_ticks, engine_hit_ticks);
+
+    // Failed lookups, using the keys that follow the inserted ones.
+    std::snprintf(case_name, sizeof(case_name), "std::unordered_map lookup miss, %s, %zu", key_type_name, element_count);
+    const u64 standard_miss_ticks = Benchmark::measure(case_name, operation_count, 0, [&]() {
+        usize found_count = 0;
+        for (u64 round_index = 0; round_index < round_count; ++round_index)
+        {
+            for (usize index = 0; index < element_count; ++index)
+                found_count += (standard_map.find(standard_keys[element_count + index]) != standard_map.end()) ? 1 : 0;
+        }
+        Benchmark::do_not_optimize(found_count);
+    });
+
+    std::snprintf(case_name, sizeof(case_name), "HashMap lookup miss, %s, %zu", key_type_name, element_count);
+    const u64 engine_miss_ticks = Benchmark::measure(case_name, operation_count, 0, [&]() {
+        usize found_count = 0;
+        for (u64 round_index = 0; round_index < round_count; ++round_index)
+        {
+            for (usize index = 0; index < element_count; ++index)
+                found_count += engine_map.contains(engine_keys[element_count + index]) ? 1 : 0;
+        }
+        Benchmark::do_not_optimize(found_count);
+    });
+    Benchmark::report_speedup("lookup miss speedup", standard_miss_ticks, engine_miss_ticks);
+}
+
+CAVE_BENCHMARK(hash_map_integer_keys)
+{
+    for (const usize element_count : hash_map_benchmark_sizes)
+    {
+        Vector<u64> keys;
+        keys.ensure_capacity(2 * element_count);
+        for (usize index = 0; index < 2 * element_count; ++index)
+            keys.add(generate_integer_key(index));
+
+        char group_name[96];
+        std::snprintf(group_name, sizeof(group_name), "HashMap<u64, usize> compared to std::unordered_map, %zu elements", element_count);
+        Benchmark::begin_group(group_name);
+        measure_hash_map<HashMap<u64, usize>, std::unordered_map<u64, usize>>("u64", element_count, keys, keys);
+    }
+}
+
+CAVE_BENCHMARK(hash_map_string_keys)
+{
+    for (const usize element_count : hash_map_benchmark_sizes)
+    {
+        // Identifiers of varying lengths, both shorter and longer than the inline capacity of the string.
+        Vector<String> engine_keys;
+        // NOTE: The standard keys are stored in a standard container, as the engine containers rely on the engine `move`.
+        std::vector<std::string> standard_keys;
+        engine_keys.ensure_capacity(2 * element_count);
+        standard_keys.reserve(2 * element_count);
+        for (usize index = 0; index < 2 * element_count; ++index)
+        {
+            char key[64];
+            const int key_length = (index % 4 == 0) ? std::snprintf(key, sizeof(key), "Entities/Props/StaticMesh_%zu", index)
+                                                    : std::snprintf(key, sizeof(key), "entity_%zu", index);
+            engine_keys.add(String(StringView::create_from_utf8(key, static_cast<usize>(key_length))));
+            standard_keys.emplace_back(key, static_cast<usize>(key_length));
+        }
+
+        char group_name[96];
+        std::snprintf(group_name, sizeof(group_name), "HashMap<String, usize> compared to std::unordered_map, %zu elements", element_count);
+        Benchmark::begin_group(group_name);
+        measure_hash_map<HashMap<String, usize>, std::unordered_map<std::string, usize>>("String", element_count, engine_keys, standard_keys);
+    }
+}
+
+} // namespace CaveGame
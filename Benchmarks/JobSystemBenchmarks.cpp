@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Benchmark.h>
+#include <Core/Jobs/JobSystem.h>
+#include <cstdio>
+#include <thread>
+
+namespace CaveGame
+{
+
+// The job system always has the main thread, so these worker thread counts correspond to 2, 4, 8 and 16 threads.
+static constexpr u32 job_system_benchmark_worker_thread_counts[] = { 1, 3, 7, 15 };
+
+static constexpr u32 job_system_benchmark_job_count = 64 * 1024;
+
+// The depth of the fork/join tree, whose leaves are the jobs that execute the work items.
+static constexpr u32 job_system_benchmark_tree_depth = 16;
+
+// NOTE: Each result occupies its own cache line, so the threads that store the results of different jobs never share one.
+struct alignas(64) JobBenchmarkResult
+{
+    u64 value;
+};
+
+// Executes a chain of dependent xorshift steps, which can't be vectorized nor computed in closed form.
+NODISCARD static u64 execute_work_item(u64 seed, u32 iteration_count)
+{
+    u64 state = seed | 1;
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+    }
+    return state;
+}
+
+//
+// Schedules the two halves of the leaf range as child jobs and waits for them, until the range has a single leaf.
+// The waiting jobs are parked, so this measures the cost of the counters and of the fiber switches as well.
+//
+static void execute_fork_join_tree(JobBenchmarkResult* results, u32 first_leaf, u32 leaf_count, u32 iteration_count)
+{
+    if (leaf_count == 1)
+    {
+        results[first_leaf].value = execute_work_item(first_leaf, iteration_count);
+        return;
+    }
+
+    const u32 half_leaf_count = leaf_count / 2;
+    JobCounter counter;
+    JobSystem::schedule([=]() { execute_fork_join_tree(results, first_leaf, half_leaf_count, iteration_count); }, &counter);
+    JobSystem::schedule([=]() { execute_fork_join_tree(results, first_leaf + half_leaf_count, half_leaf_count, iteration_count); }, &counter);
+    JobSystem::wait_for_counter(counter);
+}
+
+static void measure_independent_jobs(const char* group_name, u32 iteration_count)
+{
+    Benchmark::begin_group(group_name);
+    JobBenchmarkResult* results = new JobBenchmarkResult[job_system_benchmark_job_count];
+
+    const u64 serial_ticks = Benchmark::measure("serial, main thread only", job_system_benchmark_job_count, 0, [&]() {
+        for (u32 job_index = 0; job_index < job_system_benchmark_job_count; ++job_index)
+            results[job_index].value = execute_work_item(job_index, iteration_count);
+        Benchmark::do_not_optimize(results);
+    });
+
+    for (const u32 worker_thread_count : job_system_benchmark_worker_thread_counts)
+    {
+        Benchmark::restart_job_system(worker_thread_count);
+
+        char case_name[96];
+        std::snprintf(case_name, sizeof(case_name), "one job per item, %u threads", JobSystem::get_thread_count());
+        const u64 ticks = Benchmark::measure(case_name, job_system_benchmark_job_count, 0, [&]() {
+            JobCounter counter;
+            for (u32 job_index = 0; job_index < job_system_benchmark_job_count; ++job_index)
+            {
+                JobSystem::schedule([results, job_index, iteration_count]() { results[job_index].value = execute_work_item(job_index, iteration_count); }, &counter);
+            }
+            JobSystem::wait_for_counter(counter);
+            Benchmark::do_not_optimize(results);
+        });
+
+        std::snprintf(case_name, sizeof(case_name), "speedup over serial, %u threads", JobSystem::get_thread_count());
+        Benchmark::report_speedup(case_name, serial_ticks, ticks);
+    }
+
+    delete[] results;
+}
+
+static void measure_fork_join_tree(const char* group_name, u32 iteration_count)
+{
+    constexpr u32 leaf_count = 1U << job_system_benchmark_tree_depth;
+
+    Benchmark::begin_group(group_name);
+    JobBenchmarkResult* results = new JobBenchmarkResult[leaf_count];
+
+    const u64 serial_ticks = Benchmark::measure("serial, main thread only", leaf_count, 0, [&]() {
+        for (u32 leaf_index = 0; leaf_index < leaf_count; ++leaf_index)
+            results[leaf_index].value = execute_work_item(leaf_index, iteration_count);
+        Benchmark::do_not_optimize(results);
+    });
+
+    for (const u32 worker_thread_count : job_system_benchmark_worker_thread_counts)
+    {
+        Benchmark::restart_job_system(worker_thread_count);
+
+        char case_name[96];
+        std::snprintf(case_name, sizeof(case_name), "fork/join tree, %u threads", JobSystem::get_thread_count());
+        const u64 ticks = Benchmark::measure(case_name, leaf_count, 0, [&]() {
+            execute_fork_join_tree(results, 0, leaf_count, iteration_count);
+            Benchmark::do_not_optimize(results);
+        });
+
+        std::snprintf(case_name, sizeof(case_name), "speedup over serial, %u threads", JobSystem::get_thread_count());
+        Benchmark::report_speedup(case_name, serial_ticks, ticks);
+    }
+
+    delete[] results;
+}
+
+CAVE_BENCHMARK(job_system_scaling)
+{
+    std::printf("  hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    // NOTE: The empty jobs measure the scheduling overhead, while the larger jobs (about half a microsecond and ten
+    // microseconds of work on the reference machine) measure how well the work is spread across the threads.
+    measure_independent_jobs("independent jobs, empty", 0);
+    measure_independent_jobs("independent jobs, 256 steps each", 256);
+    measure_independent_jobs("independent jobs, 4096 steps each", 4096);
+    measure_fork_join_tree("fork/join tree of 65536 leaves, 256 steps each", 256);
+    measure_fork_join_tree("fork/join tree of 65536 leaves, 4096 steps each", 4096);
+
+    // The other benchmarks expect the job system to run with the default thread count.
+    Benchmark::restart_job_system(0);
+}
+
+} // namespace CaveGame
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Benchmark.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <Core/Platform/CPUFeatures.h>
+#include <cstdio>
+#include <cstring>
+
+namespace CaveGame
+{
+
+//
+// The sizes straddle the thresholds used by the memory operations: the small-size path handles up to 32 bytes, the
+// medium-size path up to 128 bytes, and the bulk kernels switch to non-temporal stores from half the size of the last
+// level cache (or from 4 MiB, if the cache size can't be detected).
+//
+static constexpr usize memory_benchmark_sizes[] = {
+    8,       32,      33,      128,      129,      1 * KiB,  16 * KiB,  256 * KiB,
+    1 * MiB, 2 * MiB, 4 * MiB, 16 * MiB, 32 * MiB, 64 * MiB, 128 * MiB, 256 * MiB,
+};
+
+static constexpr usize memory_benchmark_max_size = 256 * MiB;
+
+// Each case processes roughly this many bytes, but invokes the operation at most `max_call_count` times.
+static constexpr u64 memory_benchmark_bytes_per_case = 1024 * MiB;
+static constexpr u64 memory_benchmark_max_call_count = 8'000'000;
+
+static void format_byte_count(char* buffer, usize buffer_size, usize byte_count)
+{
+    if (byte_count >= MiB && byte_count % MiB == 0)
+        std::snprintf(buffer, buffer_size, "%zu MiB", byte_count / MiB);
+    else if (byte_count >= KiB && byte_count % KiB == 0)
+        std::snprintf(buffer, buffer_size, "%zu KiB", byte_count / KiB);
+    else
+        std::snprintf(buffer, buffer_size, "%zu B", byte_count);
+}
+
+//
+// Measures the engine operation and the C runtime operation for every size, and reports the speedup of the engine
+// operation. The operations receive the destination buffer, the source buffer and the size.
+//
+template<typename EngineFunction, typename RuntimeFunction>
+static void measure_memory_operation(const char* engine_name, const char* runtime_name, EngineFunction engine_function, RuntimeFunction runtime_function)
+{
+    std::printf("  last level cache: %zu KiB\n", get_cpu_features().last_level_cache_byte_count / KiB);
+
+    u8* destination = new u8[memory_benchmark_max_size];
+    u8* source = new u8[memory_benchmark_max_size];
+    // Commit the pages before measuring, so the first case doesn't pay for the page faults.
+    std::memset(destination, 0, memory_benchmark_max_size);
+    std::memset(source, 0x5A, memory_benchmark_max_size);
+
+    for (const usize size : memory_benchmark_sizes)
+    {
+        u64 call_count = memory_benchmark_bytes_per_case / size;
+        if (call_count > memory_benchmark_max_call_count)
+            call_count = memory_benchmark_max_call_count;
+        if (call_count == 0)
+            call_count = 1;
+
+        // NOTE: The size is passed through an opaque value, so the compiler can't specialize the calls for it.
+        usize byte_count = size;
+        Benchmark::do_not_optimize(byte_count);
+
+        char size_name[32];
+        char case_name[96];
+        format_byte_count(size_name, sizeof(size_name), size);
+
+        std::snprintf(case_name, sizeof(case_name), "%s, %s", runtime_name, size_name);
+        const u64 runtime_ticks = Benchmark::measure(case_name, call_count, call_count * size, [&]() {
+            for (u64 call_index = 0; call_index < call_count; ++call_index)
+            {
+                runtime_function(destination, source, byte_count);
+                Benchmark::do_not_optimize(destination);
+            }
+        });
+
+        std::snprintf(case_name, sizeof(case_name), "%s, %s", engine_name, size_name);
+        const u64 engine_ticks = Benchmark::measure(case_name, call_count, call_count * size, [&]() {
+            for (u64 call_index = 0; call_index < call_count; ++call_index)
+            {
+                engine_function(destination, source, byte_count);
+                Benchmark::do_not_optimize(destination);
+            }
+        });
+
+        std::snprintf(case_name, sizeof(case_name), "speedup, %s", size_name);
+        Benchmark::report_speedup(case_name, runtime_ticks, engine_ticks);
+    }
+
+    delete[] destination;
+    delete[] source;
+}
+
+CAVE_BENCHMARK(memory_copy)
+{
+    Benchmark::begin_group("copy_memory compared to std::memcpy");
+    measure_memory_operation(
+        "copy_memory",
+        "std::memcpy",
+        [](u8* destination, const u8* source, usize byte_count) { copy_memory(destination, source, byte_count); },
+        [](u8* destination, const u8* source, usize byte_count) { std::memcpy(destination, source, byte_count); });
+}
+
+CAVE_BENCHMARK(memory_set)
+{
+    Benchmark::begin_group("set_memory compared to std::memset");
+    measure_memory_operation(
+        "set_memory",
+        "std::memset",
+        [](u8* destination, const u8*, usize byte_count) { set_memory(destination, 0xA5, byte_count); },
+        [](u8* destination, const u8*, usize byte_count) { std::memset(destination, 0xA5, byte_count); });
+}
+
+CAVE_BENCHMARK(memory_zero)
+{
+    Benchmark::begin_group("zero_memory compared to std::memset");
+    measure_memory_operation(
+        "zero_memory",
+        "std::memset",
+        [](u8* destination, const u8*, usize byte_count) { zero_memory(destination, byte_count); },
+        [](u8* destination, const u8*, usize byte_count) { std::memset(destination, 0, byte_count); });
+}
+
+} // namespace CaveGame
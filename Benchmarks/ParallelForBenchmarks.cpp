@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Benchmark.h>
+#include <Core/Containers/Vector.h>
+#include <Core/Jobs/ParallelFor.h>
+#include <Core/Math/Matrix.h>
+#include <Core/Math/Vector.h>
+#include <cstdio>
+#include <thread>
+
+namespace CaveGame
+{
+
+// The job system always has the main thread, so these worker thread counts correspond to 2, 4, 8 and 16 threads.
+static constexpr u32 parallel_for_benchmark_worker_thread_counts[] = { 1, 3, 7, 15 };
+
+static constexpr usize parallel_for_benchmark_element_count = 1024 * 1024;
+
+// The grain sizes measured in addition to the automatically selected one.
+static constexpr usize parallel_for_benchmark_grain_sizes[] = { 1024, 16 * 1024 };
+
+// Rotates and translates the position, as done when moving a batch of entities or particles to world space.
+NODISCARD ALWAYS_INLINE static Vector3 transform_position(const Matrix3& rotation, Vector3 translation, Vector3 position)
+{
+    return Vector3(
+        Vector3::dot(rotation.rows[0], position) + translation.x,
+        Vector3::dot(rotation.rows[1], position) + translation.y,
+        Vector3::dot(rotation.rows[2], position) + translation.z
+    );
+}
+
+// Also normalizes the transformed position, which adds a square root and a division to each element.
+NODISCARD ALWAYS_INLINE static Vector3 transform_direction(const Matrix3& rotation, Vector3 translation, Vector3 position)
+{
+    return Vector3::normalize(transform_position(rotation, translation, position));
+}
+
+//
+// Measures the transform of all input positions into the output positions, serially on the main thread and using
+// `parallel_for` with each of the thread counts and grain sizes.
+//
+template<typename TransformFunction>
+static void measure_parallel_transform(const char* group_name, const Vector<Vector3>& input, Vector<Vector3>& output, TransformFunction transform_function)
+{
+    const Vector3* input_elements = input.elements();
+    Vector3* output_elements = output.elements();
+    const usize element_count = input.count();
+
+    // Each element is read from the input and written to the output.
+    const u64 byte_count = 2 * element_count * sizeof(Vector3);
+
+    Benchmark::begin_group(group_name);
+    const u64 serial_ticks = Benchmark::measure("serial, main thread only", element_count, byte_count, [&]() {
+        for (usize index = 0; index < element_count; ++index)
+            output_elements[index] = transform_function(input_elements[index]);
+        Benchmark::do_not_optimize(output_elements);
+    });
+
+    for (const u32 worker_thread_count : parallel_for_benchmark_worker_thread_counts)
+    {
+        Benchmark::restart_job_system(worker_thread_count);
+        const u32 thread_count = JobSystem::get_thread_count();
+
+        const auto measure_grain_size = [&](usize grain_size) {
+            char case_name[96];
+            if (grain_size == auto_grain_size)
+                std::snprintf(case_name, sizeof(case_name), "parallel_for, %u threads, auto grain", thread_count);
+            else
+                std::snprintf(case_name, sizeof(case_name), "parallel_for, %u threads, grain %zu", thread_count, grain_size);
+
+            const u64 ticks = Benchmark::measure(case_name, element_count, byte_count, [&]() {
+                parallel_for(0, element_count, grain_size, [&](usize begin, usize end) {
+                    for (usize index = begin; index < end; ++index)
+                        output_elements[index] = transform_function(input_elements[index]);
+                });
+                Benchmark::do_not_optimize(output_elements);
+            });
+
+            Benchmark::report_speedup("speedup over serial", serial_ticks, ticks);
+        };
+
+        measure_grain_size(auto_grain_size);
+        for (const usize grain_size : parallel_for_benchmark_grain_sizes)
+            measure_grain_size(grain_size);
+    }
+}
+
+CAVE_BENCHMARK(parallel_for_transform)
+{
+    std::printf("  hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    Vector<Vector3> input;
+    Vector<Vector3> output;
+    input.ensure_capacity(parallel_for_benchmark_element_count);
+    for (usize index = 0; index < parallel_for_benchmark_element_count; ++index)
+    {
+        const float value = static_cast<float>(index);
+        input.add(Vector3(value, 0.5F * value + 1.0F, 64.0F - value));
+    }
+    output.set_count(parallel_for_benchmark_element_count, Vector3(0));
+
+    // A rotation of 30 degrees around the Y axis.
+    const Matrix3 rotation = Matrix3(Vector3(0.8660254F, 0.0F, 0.5F), Vector3(0.0F, 1.0F, 0.0F), Vector3(-0.5F, 0.0F, 0.8660254F));
+    const Vector3 translation = Vector3(16.0F, 64.0F, -16.0F);
+
+    measure_parallel_transform(
+        "Vector<Vector3> transform, 1M elements",
+        input,
+        output,
+        [&](Vector3 position) { return transform_position(rotation, translation, position); }
+    );
+
+    measure_parallel_transform(
+        "Vector<Vector3> transform and normalize, 1M elements",
+        input,
+        output,
+        [&](Vector3 position) { return transform_direction(rotation, translation, position); }
+    );
+
+    // The other benchmarks expect the job system to run with the default thread count.
+    Benchmark::restart_job_system(0);
+}
+
+} // namespace CaveGame
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Benchmark.h>
+#include <Core/Containers/MPMCQueue.h>
+#include <Core/Containers/SPSCRingBuffer.h>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace CaveGame
+{
+
+static constexpr u32 queue_benchmark_capacity = 1024;
+
+// The number of elements transferred through the queue in each throughput case, divided between the producers.
+static constexpr u64 queue_benchmark_element_count = 2 * 1024 * 1024;
+
+// The number of round trips made in each latency case.
+static constexpr u64 queue_benchmark_round_trip_count = 100'000;
+
+// The number of elements pushed and popped at once by the batch operations of the ring buffer.
+static constexpr u32 queue_benchmark_batch_count = 64;
+
+// The producer and consumer counts of the contended cases, which use between 2 and 32 threads.
+static constexpr u32 queue_benchmark_producer_counts[] = { 1, 2, 4, 8, 16 };
+
+//
+// A ring buffer protected by a mutex, used as the baseline for the lock-free queues. Has the same interface as the
+// `MPMCQueue`, for the subset used by the benchmarks.
+//
+template<typename T, u32 Capacity>
+class LockedQueue
+{
+public:
+    NODISCARD bool try_push(const T& element)
+    {
+        std::scoped_lock lock(m_mutex);
+        if (m_write_index - m_read_index == Capacity)
+            return false;
+        m_elements[m_write_index++ % Capacity] = element;
+        return true;
+    }
+
+    NODISCARD bool try_pop(T& out_element)
+    {
+        std::scoped_lock lock(m_mutex);
+        if (m_write_index == m_read_index)
+            return false;
+        out_element = m_elements[m_read_index++ % Capacity];
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    u64 m_write_index { 0 };
+    u64 m_read_index { 0 };
+    T m_elements[Capacity];
+};
+
+// NOTE: Each sum occupies its own cache line, so the consumers never share one.
+struct alignas(64) QueueBenchmarkSum
+{
+    u64 value;
+};
+
+//
+// Pushes and pops the element, retrying until the operation succeeds. The thread yields between the attempts, so that
+// the benchmark also makes progress when there are more threads than processor cores.
+//
+template<typename QueueType>
+ALWAYS_INLINE static void push_until_success(QueueType& queue, u64 element)
+{
+    while (!queue.try_push(element))
+        std::this_thread::yield();
+}
+
+template<typename QueueType>
+ALWAYS_INLINE static u64 pop_until_success(QueueType& queue)
+{
+    u64 element;
+    while (!queue.try_pop(element))
+        std::this_thread::yield();
+    return element;
+}
+
+//
+// Transfers `queue_benchmark_element_count` elements from the producers to the consumers. Each consumer pops exactly
+// its share of the elements, so the threads never need a shared counter to know when to stop. The sum of the popped
+// elements is checked, which verifies that every element was popped exactly once.
+// NOTE: The measured time includes the creation of the threads, which is negligible compared to the transfers.
+//
+template<typename QueueType>
+static u64 measure_queue_throughput(const char* case_name, QueueType& queue, u32 producer_count, u32 consumer_count)
+{
+    const u64 elements_per_producer = queue_benchmark_element_count / producer_count;
+    const u64 elements_per_consumer = queue_benchmark_element_count / consumer_count;
+
+    QueueBenchmarkSum sums[16];
+    const u64 ticks = Benchmark::measure(case_name, queue_benchmark_element_count, 0, [&]() {
+        std::thread threads[32];
+        for (u32 consumer_index = 0; consumer_index < consumer_count; ++consumer_index)
+        {
+            threads[consumer_index] = std::thread([&queue, &sums, consumer_index, elements_per_consumer]() {
+                u64 sum = 0;
+                for (u64 element_index = 0; element_index < elements_per_consumer; ++element_index)
+                    sum += pop_until_success(queue);
+                sums[consumer_index].value = sum;
+            });
+        }
+
+        for (u32 producer_index = 0; producer_index < producer_count; ++producer_index)
+        {
+            threads[consumer_count + producer_index] = std::thread([&queue, producer_index, elements_per_producer]() {
+                const u64 first_element = producer_index * elements_per_producer;
+                for (u64 element_index = 0; element_index < elements_per_producer; ++element_index)
+                    push_until_success(queue, first_element + element_index);
+            });
+        }
+
+        for (u32 thread_index = 0; thread_index < producer_count + consumer_count; ++thread_index)
+            threads[thread_index].join();
+    });
+
+    u64 sum = 0;
+    for (u32 consumer_index = 0; consumer_index < consumer_count; ++consumer_index)
+        sum += sums[consumer_index].value;
+    if (sum != (queue_benchmark_element_count * (queue_benchmark_element_count - 1)) / 2)
+        std::printf("  ERROR: The elements popped from the queue don't match the pushed ones!\n");
+
+    return ticks;
+}
+
+//
+// Bounces an element between the main thread and a second thread, through a queue in each direction. The time of an
+// item is the time of a round trip, which is twice the latency of handing an element over to another thread.
+//
+template<typename QueueType>
+static u64 measure_queue_round_trip(const char* case_name, QueueType& request_queue, QueueType& response_queue)
+{
+    return Benchmark::measure(case_name, queue_benchmark_round_trip_count, 0, [&]() {
+        std::thread echo_thread([&request_queue, &response_queue]() {
+            for (u64 round_trip_index = 0; round_trip_index < queue_benchmark_round_trip_count; ++round_trip_index)
+                push_until_success(response_queue, pop_until_success(request_queue));
+        });
+
+        u64 sum = 0;
+        for (u64 round_trip_index = 0; round_trip_index < queue_benchmark_round_trip_count; ++round_trip_index)
+        {
+            push_until_success(request_queue, round_trip_index);
+            sum += pop_until_success(response_queue);
+        }
+
+        echo_thread.join();
+        Benchmark::do_not_optimize(sum);
+    });
+}
+
+CAVE_BENCHMARK(queue_contention)
+{
+    std::printf("  hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    using LockFreeQueue = MPMCQueue<u64, queue_benchmark_capacity>;
+    using LockedBaselineQueue = LockedQueue<u64, queue_benchmark_capacity>;
+
+    // NOTE: The queues store their elements inline, so they are allocated on the heap.
+    LockFreeQueue* lock_free_queue = new LockFreeQueue();
+    LockedBaselineQueue* locked_queue = new LockedBaselineQueue();
+
+    // A single thread that pushes and pops, which measures the cost of the operations without any contention.
+    Benchmark::begin_group("push and pop, single thread");
+    const u64 locked_single_ticks = Benchmark::measure("mutex + ring buffer", queue_benchmark_element_count, 0, [&]() {
+        u64 sum = 0;
+        for (u64 element_index = 0; element_index < queue_benchmark_element_count; ++element_index)
+        {
+            push_until_success(*locked_queue, element_index);
+            sum += pop_until_success(*locked_queue);
+        }
+        Benchmark::do_not_optimize(sum);
+    });
+    const u64 lock_free_single_ticks = Benchmark::measure("MPMCQueue", queue_benchmark_element_count, 0, [&]() {
+        u64 sum = 0;
+        for (u64 element_index = 0; element_index < queue_benchmark_element_count; ++element_index)
+        {
+            push_until_success(*lock_free_queue, element_index);
+            sum += pop_until_success(*lock_free_queue);
+        }
+        Benchmark::do_not_optimize(sum);
+    });
+    Benchmark::report_speedup("speedup", locked_single_ticks, lock_free_single_ticks);
+
+    // The same number of producers and consumers, all of them contending for both ends of the queue.
+    for (const u32 producer_count : queue_benchmark_producer_counts)
+    {
+        char group_name[96];
+        std::snprintf(group_name, sizeof(group_name), "throughput, %u threads (%u producers, %u consumers)", 2 * producer_count, producer_count, producer_count);
+        Benchmark::begin_group(group_name);
+
+        const u64 locked_ticks = measure_queue_throughput("mutex + ring buffer", *locked_queue, producer_count, producer_count);
+        const u64 lock_free_ticks = measure_queue_throughput("MPMCQueue", *lock_free_queue, producer_count, producer_count);
+        Benchmark::report_speedup("speedup", locked_ticks, lock_free_ticks);
+    }
+
+    delete lock_free_queue;
+    delete locked_queue;
+
+    // Latency of handing an element over to another thread and back.
+    Benchmark::begin_group("round trip latency between two threads");
+    LockFreeQueue* lock_free_queues = new LockFreeQueue[2];
+    LockedBaselineQueue* locked_queues = new LockedBaselineQueue[2];
+    const u64 locked_round_trip_ticks = measure_queue_round_trip("mutex + ring buffer", locked_queues[0], locked_queues[1]);
+    const u64 lock_free_round_trip_ticks = measure_queue_round_trip("MPMCQueue", lock_free_queues[0], lock_free_queues[1]);
+    Benchmark::report_speedup("speedup", locked_round_trip_ticks, lock_free_round_trip_ticks);
+    delete[] lock_free_queues;
+    delete[] locked_queues;
+}
+
+CAVE_BENCHMARK(spsc_ring_buffer)
+{
+    using RingBuffer = SPSCRingBuffer<u64, queue_benchmark_capacity>;
+    using LockFreeQueue = MPMCQueue<u64, queue_benchmark_capacity>;
+
+    std::printf("  hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    Benchmark::begin_group("throughput, one producer and one consumer");
+    LockFreeQueue* lock_free_queue = new LockFreeQueue();
+    const u64 lock_free_ticks = measure_queue_throughput("MPMCQueue", *lock_free_queue, 1, 1);
+    delete lock_free_queue;
+
+    RingBuffer* ring_buffer = new RingBuffer();
+    const u64 ring_buffer_ticks = measure_queue_throughput("SPSCRingBuffer", *ring_buffer, 1, 1);
+    Benchmark::report_speedup("speedup over MPMCQueue", lock_free_ticks, ring_buffer_ticks);
+
+    // The batch operations publish the elements of a whole batch with a single store.
+    const u64 batch_ticks = Benchmark::measure("SPSCRingBuffer, batches of 64", queue_benchmark_element_count, 0, [&]() {
+        std::thread consumer_thread([ring_buffer]() {
+            u64 batch[queue_benchmark_batch_count];
+            u64 sum = 0;
+            u64 popped_count = 0;
+            while (popped_count < queue_benchmark_element_count)
+            {
+                const u32 pop_count = ring_buffer->pop_batch(batch, queue_benchmark_batch_count);
+                if (pop_count == 0)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (u32 element_index = 0; element_index < pop_count; ++element_index)
+                    sum += batch[element_index];
+                popped_count += pop_count;
+            }
+            Benchmark::do_not_optimize(sum);
+        });
+
+        u64 batch[queue_benchmark_batch_count];
+        for (u64 first_element = 0; first_element < queue_benchmark_element_count; first_element += queue_benchmark_batch_count)
+        {
+            for (u32 element_index = 0; element_index < queue_benchmark_batch_count; ++element_index)
+                batch[element_index] = first_element + element_index;
+
+            u32 pushed_count = 0;
+            while (pushed_count < queue_benchmark_batch_count)
+            {
+                const u32 push_count = ring_buffer->push_batch(batch + pushed_count, queue_benchmark_batch_count - pushed_count);
+                if (push_count == 0)
+                    std::this_thread::yield();
+                pushed_count += push_count;
+            }
+        }
+
+        consumer_thread.join();
+    });
+    Benchmark::report_speedup("speedup over MPMCQueue", lock_free_ticks, batch_ticks);
+    delete ring_buffer;
+
+    Benchmark::begin_group("round trip latency between two threads");
+    LockFreeQueue* lock_free_queues = new LockFreeQueue[2];
+    const u64 lock_free_round_trip_ticks = measure_queue_round_trip("MPMCQueue", lock_free_queues[0], lock_free_queues[1]);
+    delete[] lock_free_queues;
+
+    RingBuffer* ring_buffers = new RingBuffer[2];
+    const u64 ring_buffer_round_trip_ticks = measure_queue_round_trip("SPSCRingBuffer", ring_buffers[0], ring_buffers[1]);
+    Benchmark::report_speedup("speedup over MPMCQueue", lock_free_round_trip_ticks, ring_buffer_round_trip_ticks);
+    delete[] ring_buffers;
+}
+
+} // namespace CaveGame
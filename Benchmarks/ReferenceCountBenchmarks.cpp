@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Benchmark.h>
+#include <Core/Containers/RefPtr.h>
+#include <cstdio>
+#include <thread>
+
+namespace CaveGame
+{
+
+// NOTE: Each object occupies its own cache line, so the threads that copy references to different objects never share one.
+struct alignas(64) AtomicBenchmarkObject : public RefCounted
+{
+    u64 payload { 0 };
+};
+
+struct NonAtomicBenchmarkObject : public RefCountedNonAtomic
+{
+    u64 payload { 0 };
+};
+
+static constexpr u32 reference_count_benchmark_thread_counts[] = { 1, 2, 4, 8, 16 };
+
+// The number of reference copies (each one is an increment followed by a decrement) made by each thread.
+static constexpr u64 reference_count_benchmark_copies_per_thread = 4'000'000;
+
+// Copies the reference and releases the copy, which increments and then decrements the reference count.
+template<typename T>
+static void copy_reference_repeatedly(const RefPtr<T>& reference, u64 copy_count)
+{
+    for (u64 copy_index = 0; copy_index < copy_count; ++copy_index)
+    {
+        RefPtr<T> copy = reference;
+        Benchmark::do_not_optimize(copy);
+    }
+}
+
+//
+// Executes the reference copies on the given number of threads, which either share a single object (so all threads
+// modify the same reference count) or each copy the reference to their own object.
+//
+static u64 measure_contended_copies(const char* case_name, u32 thread_count, bool share_object)
+{
+    RefPtr<AtomicBenchmarkObject> objects[16];
+    for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+        objects[thread_index] = share_object && thread_index > 0 ? objects[0] : create_ref<AtomicBenchmarkObject>();
+
+    const u64 copy_count = thread_count * reference_count_benchmark_copies_per_thread;
+    return Benchmark::measure(case_name, copy_count, 0, [&]() {
+        std::thread threads[16];
+        for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+        {
+            threads[thread_index] = std::thread([&objects, thread_index]() {
+                copy_reference_repeatedly(objects[thread_index], reference_count_benchmark_copies_per_thread);
+            });
+        }
+
+        for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+            threads[thread_index].join();
+    });
+}
+
+CAVE_BENCHMARK(reference_count_single_thread)
+{
+    Benchmark::begin_group("RefPtr copy and release, single thread");
+
+    const RefPtr<NonAtomicBenchmarkObject> non_atomic_object = create_ref<NonAtomicBenchmarkObject>();
+    const u64 non_atomic_ticks = Benchmark::measure("RefCountedNonAtomic", reference_count_benchmark_copies_per_thread, 0, [&]() {
+        copy_reference_repeatedly(non_atomic_object, reference_count_benchmark_copies_per_thread);
+    });
+
+    const RefPtr<AtomicBenchmarkObject> atomic_object = create_ref<AtomicBenchmarkObject>();
+    const u64 atomic_ticks = Benchmark::measure("RefCounted (uncontended)", reference_count_benchmark_copies_per_thread, 0, [&]() {
+        copy_reference_repeatedly(atomic_object, reference_count_benchmark_copies_per_thread);
+    });
+
+    Benchmark::report_speedup("non-atomic speedup", atomic_ticks, non_atomic_ticks);
+}
+
+CAVE_BENCHMARK(reference_count_contention)
+{
+    std::printf("  hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    for (const u32 thread_count : reference_count_benchmark_thread_counts)
+    {
+        char group_name[96];
+        std::snprintf(group_name, sizeof(group_name), "RefCounted copy and release, %u threads", thread_count);
+        Benchmark::begin_group(group_name);
+
+        // NOTE: The items are the copies made by all threads, so the time per item is the throughput cost of a copy.
+        const u64 private_ticks = measure_contended_copies("one object per thread", thread_count, false);
+        const u64 shared_ticks = measure_contended_copies("one object shared by all threads", thread_count, true);
+        Benchmark::report_speedup("contention slowdown", shared_ticks, private_ticks);
+    }
+}
+
+} // namespace CaveGame
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Benchmark.h>
+#include <Core/Containers/String.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace CaveGame
+{
+
+//
+// Identifiers as they appear in the game: block names, asset keys, log tags, shader and stage names. Most of them are
+// shorter than 23 bytes and are stored inline, while the asset paths are long enough to be stored on the heap.
+//
+static const char* const string_benchmark_corpus[] = {
+    // Block names.
+    "air", "stone", "grass", "dirt", "cobblestone", "oak_planks", "oak_log", "oak_leaves", "sand", "gravel",
+    "water", "lava", "bedrock", "coal_ore", "iron_ore", "gold_ore", "diamond_ore", "glass", "torch",
+    "crafting_table", "furnace", "chest", "spruce_log", "birch_leaves", "mossy_cobblestone", "stone_bricks",
+    // Log tags.
+    "Engine", "Renderer", "JobSystem", "FrameAllocator", "Window", "Input", "Audio", "World", "ChunkMesher",
+    // Stage and resource names.
+    "UpdatePhysics", "GenerateChunks", "BuildMeshes", "CullChunks", "Lighting", "Meshes", "Entities",
+    "PlayerController", "ParticleSystem", "PostProcessing",
+    // Asset keys.
+    "Textures/Blocks/grass_top.png", "Textures/Blocks/oak_log_side.png", "Shaders/Chunk.vertex.hlsl",
+    "Shaders/Chunk.pixel.hlsl", "Models/Entities/zombie.mesh", "Sounds/Blocks/stone_break_03.ogg",
+};
+
+static constexpr usize string_benchmark_corpus_count = sizeof(string_benchmark_corpus) / sizeof(string_benchmark_corpus[0]);
+
+// Each case processes the corpus this many times.
+static constexpr u64 string_benchmark_round_count = 100'000;
+
+CAVE_BENCHMARK(string_churn)
+{
+    StringView corpus_views[string_benchmark_corpus_count];
+    usize inline_count = 0;
+    usize corpus_byte_count = 0;
+    for (usize index = 0; index < string_benchmark_corpus_count; ++index)
+    {
+        corpus_views[index] = StringView::create_from_utf8(string_benchmark_corpus[index]);
+        corpus_byte_count += corpus_views[index].byte_count();
+        if (String(corpus_views[index]).is_stored_inline())
+            ++inline_count;
+    }
+
+    std::printf("  corpus: %zu identifiers, %zu stored inline, %zu bytes\n", string_benchmark_corpus_count, inline_count, corpus_byte_count);
+
+    const u64 operation_count = string_benchmark_round_count * string_benchmark_corpus_count;
+    const u64 byte_count = string_benchmark_round_count * corpus_byte_count;
+
+    // Construction from a view, followed by the destruction.
+    Benchmark::begin_group("construct and destroy");
+    const u64 standard_construct_ticks = Benchmark::measure("std::string", operation_count, byte_count, [&]() {
+        for (u64 round_index = 0; round_index < string_benchmark_round_count; ++round_index)
+        {
+            for (const char* identifier : string_benchmark_corpus)
+            {
+                std::string string(identifier, std::strlen(identifier));
+                Benchmark::do_not_optimize(string);
+            }
+        }
+    });
+    const u64 engine_construct_ticks = Benchmark::measure("String", operation_count, byte_count, [&]() {
+        for (u64 round_index = 0; round_index < string_benchmark_round_count; ++round_index)
+        {
+            for (const StringView& view : corpus_views)
+            {
+                String string(view);
+                Benchmark::do_not_optimize(string);
+            }
+        }
+    });
+    Benchmark::report_speedup("speedup", standard_construct_ticks, engine_construct_ticks);
+
+    // Copies of existing strings, which only bump the reference count for the heap-allocated ones.
+    String engine_strings[string_benchmark_corpus_count];
+    std::string standard_strings[string_benchmark_corpus_count];
+    for (usize index = 0; index < string_benchmark_corpus_count; ++index)
+    {
+        engine_strings[index] = corpus_views[index];
+        standard_strings[index].assign(corpus_views[index].characters(), corpus_views[index].byte_count());
+    }
+
+    Benchmark::begin_group("copy and destroy");
+    const u64 standard_copy_ticks = Benchmark::measure("std::string", operation_count, byte_count, [&]() {
+        for (u64 round_index = 0; round_index < string_benchmark_round_count; ++round_index)
+        {
+            for (const std::string& source : standard_strings)
+            {
+                std::string string = source;
+                Benchmark::do_not_optimize(string);
+            }
+        }
+    });
+    const u64 engine_copy_ticks = Benchmark::measure("String", operation_count, byte_count, [&]() {
+        for (u64 round_index = 0; round_index < string_benchmark_round_count; ++round_index)
+        {
+            for (const String& source : engine_strings)
+            {
+                String string = source;
+                Benchmark::do_not_optimize(string);
+            }
+        }
+    });
+    Benchmark::report_speedup("speedup", standard_copy_ticks, engine_copy_ticks);
+
+    // The usual lifetime of a temporary identifier: constructed, copied into a few places, assigned, destroyed.
+    Benchmark::begin_group("construct, copy twice, assign and destroy");
+    const u64 standard_churn_ticks = Benchmark::measure("std::string", operation_count, byte_count, [&]() {
+        std::string assigned;
+        for (u64 round_index = 0; round_index < string_benchmark_round_count; ++round_index)
+        {
+            for (const char* identifier : string_benchmark_corpus)
+            {
+                std::string string(identifier, std::strlen(identifier));
+                std::string first_copy = string;
+                std::string second_copy = first_copy;
+                assigned = second_copy;
+                Benchmark::do_not_optimize(string);
+                Benchmark::do_not_optimize(first_copy);
+                Benchmark::do_not_optimize(second_copy);
+            }
+        }
+        Benchmark::do_not_optimize(assigned);
+    });
+    const u64 engine_churn_ticks = Benchmark::measure("String", operation_count, byte_count, [&]() {
+        String assigned;
+        for (u64 round_index = 0; round_index < string_benchmark_round_count; ++round_index)
+        {
+            for (const StringView& view : corpus_views)
+            {
+                String string(view);
+                String first_copy = string;
+                String second_copy = first_copy;
+                assigned = second_copy;
+                Benchmark::do_not_optimize(string);
+                Benchmark::do_not_optimize(first_copy);
+                Benchmark::do_not_optimize(second_copy);
+            }
+        }
+        Benchmark::do_not_optimize(assigned);
+    });
+    Benchmark::report_speedup("speedup", standard_churn_ticks, engine_churn_ticks);
+}
+
+} // namespace CaveGame
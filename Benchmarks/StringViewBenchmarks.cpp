@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Benchmark.h>
+#include <Core/Containers/StringView.h>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+
+namespace CaveGame
+{
+
+//
+// The texts are built by repeating lines of a block registry. The ASCII text is the common case, while the mixed text
+// contains two, three and four byte sequences, which disable the ASCII fast paths of the kernels.
+//
+static const char* const string_view_benchmark_ascii_line = "block \"oak_log\" { hardness = 2.0; texture = \"Textures/Blocks/oak_log_side.png\"; }\n";
+static const char* const string_view_benchmark_mixed_line = "block \"größe_木材\" { hardness = 2.0; name = \"Eichenstamm 🌲 オーク\"; }\n";
+
+static constexpr usize string_view_benchmark_sizes[] = { 4 * KiB, 16 * MiB };
+
+// Each case processes at least this many bytes, by repeating the operation on the smaller texts.
+static constexpr u64 string_view_benchmark_min_byte_count = 512 * MiB;
+
+// Byte-by-byte UTF-8 validation, used as the baseline for the vectorized validation.
+NODISCARD static bool is_valid_utf8_byte_by_byte(const u8* bytes, usize byte_count)
+{
+    usize offset = 0;
+    while (offset < byte_count)
+    {
+        const u8 lead_byte = bytes[offset];
+        if (lead_byte < 0x80)
+        {
+            ++offset;
+            continue;
+        }
+
+        usize sequence_byte_count;
+        u32 codepoint;
+        if ((lead_byte & 0xE0) == 0xC0)
+        {
+            sequence_byte_count = 2;
+            codepoint = lead_byte & 0x1F;
+        }
+        else if ((lead_byte & 0xF0) == 0xE0)
+        {
+            sequence_byte_count = 3;
+            codepoint = lead_byte & 0x0F;
+        }
+        else if ((lead_byte & 0xF8) == 0xF0)
+        {
+            sequence_byte_count = 4;
+            codepoint = lead_byte & 0x07;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (offset + sequence_byte_count > byte_count)
+            return false;
+
+        for (usize byte_index = 1; byte_index < sequence_byte_count; ++byte_index)
+        {
+            const u8 continuation_byte = bytes[offset + byte_index];
+            if ((continuation_byte & 0xC0) != 0x80)
+                return false;
+            codepoint = (codepoint << 6) | (continuation_byte & 0x3F);
+        }
+
+        // Overlong encodings, surrogates and codepoints outside the Unicode range are not valid.
+        const u32 min_codepoint = (sequence_byte_count == 2) ? 0x80 : (sequence_byte_count == 3) ? 0x800 : 0x10000;
+        if (codepoint < min_codepoint || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+            return false;
+
+        offset += sequence_byte_count;
+    }
+
+    return true;
+}
+
+// Byte-by-byte codepoint counting, used as the baseline for the vectorized counting.
+NODISCARD static usize count_codepoints_byte_by_byte(const u8* bytes, usize byte_count)
+{
+    usize codepoint_count = 0;
+    for (usize offset = 0; offset < byte_count; ++offset)
+        codepoint_count += ((bytes[offset] & 0xC0) != 0x80) ? 1 : 0;
+    return codepoint_count;
+}
+
+// Fills the buffer with whole copies of the line, followed by spaces. The buffer is always valid UTF-8.
+static void fill_text(char* text, usize byte_count, const char* line)
+{
+    const usize line_byte_count = std::strlen(line);
+    usize offset = 0;
+    while (offset + line_byte_count <= byte_count)
+    {
+        std::memcpy(text + offset, line, line_byte_count);
+        offset += line_byte_count;
+    }
+    std::memset(text + offset, ' ', byte_count - offset);
+}
+
+//
+// Measures the vectorized and the baseline implementation of an operation over the text, repeating it as many times as
+// required to process `string_view_benchmark_min_byte_count` bytes.
+//
+template<typename EngineFunction, typename BaselineFunction>
+static void measure_string_view_operation(const char* operation_name, const char* baseline_name, usize text_byte_count, EngineFunction engine_function, BaselineFunction baseline_function)
+{
+    const u64 repetition_count = (string_view_benchmark_min_byte_count + text_byte_count - 1) / text_byte_count;
+    const u64 byte_count = repetition_count * text_byte_count;
+    char case_name[96];
+
+    std::snprintf(case_name, sizeof(case_name), "%s: %s", operation_name, baseline_name);
+    const u64 baseline_ticks = Benchmark::measure(case_name, repetition_count, byte_count, [&]() {
+        for (u64 repetition_index = 0; repetition_index < repetition_count; ++repetition_index)
+            Benchmark::do_not_optimize(baseline_function());
+    });
+
+    std::snprintf(case_name, sizeof(case_name), "%s: StringView", operation_name);
+    const u64 engine_ticks = Benchmark::measure(case_name, repetition_count, byte_count, [&]() {
+        for (u64 repetition_index = 0; repetition_index < repetition_count; ++repetition_index)
+            Benchmark::do_not_optimize(engine_function());
+    });
+
+    std::snprintf(case_name, sizeof(case_name), "%s: speedup", operation_name);
+    Benchmark::report_speedup(case_name, baseline_ticks, engine_ticks);
+}
+
+static void measure_string_view_kernels(const char* text_name, const char* line)
+{
+    for (const usize text_byte_count : string_view_benchmark_sizes)
+    {
+        char* text = new char[text_byte_count];
+        fill_text(text, text_byte_count, line);
+
+        const u8* bytes = reinterpret_cast<const u8*>(text);
+        const StringView view = StringView::create_from_utf8(text, text_byte_count);
+        const std::string_view standard_view = std::string_view(text, text_byte_count);
+
+        char group_name[96];
+        std::snprintf(group_name, sizeof(group_name), "StringView kernels, %s text, %zu KiB", text_name, text_byte_count / KiB);
+        Benchmark::begin_group(group_name);
+
+        measure_string_view_operation(
+            "is_valid_utf8",
+            "byte by byte",
+            text_byte_count,
+            [&]() { return StringView::is_valid_utf8(text, text_byte_count); },
+            [&]() { return is_valid_utf8_byte_by_byte(bytes, text_byte_count); });
+
+        measure_string_view_operation(
+            "codepoint_count",
+            "byte by byte",
+            text_byte_count,
+            [&]() { return view.codepoint_count(); },
+            [&]() { return count_codepoints_byte_by_byte(bytes, text_byte_count); });
+
+        // NOTE: The searched characters and substrings are not present in the text, so the whole text is scanned.
+        measure_string_view_operation(
+            "find(char)",
+            "std::memchr",
+            text_byte_count,
+            [&]() { return view.find('@'); },
+            [&]() { return std::memchr(text, '@', text_byte_count); });
+
+        measure_string_view_operation(
+            "find(substring)",
+            "std::string_view::find",
+            text_byte_count,
+            [&]() { return view.find("oak_leaves"sv); },
+            [&]() { return standard_view.find("oak_leaves"); });
+
+        measure_string_view_operation(
+            "find_any_of",
+            "std::string_view::find_first_of",
+            text_byte_count,
+            [&]() { return view.find_any_of("@#$%"sv); },
+            [&]() { return standard_view.find_first_of("@#$%"); });
+
+        delete[] text;
+    }
+}
+
+CAVE_BENCHMARK(string_view_kernels_ascii)
+{
+    measure_string_view_kernels("ASCII", string_view_benchmark_ascii_line);
+}
+
+CAVE_BENCHMARK(string_view_kernels_mixed)
+{
+    measure_string_view_kernels("mixed UTF-8", string_view_benchmark_mixed_line);
+}
+
+} // namespace CaveGame
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Benchmark.h>
+#include <Core/Containers/Vector.h>
+#include <Core/Math/Vector.h>
+
+namespace CaveGame
+{
+
+//
+// Same layout as `Vector3`, but with a user-provided copy constructor, which makes it not trivially copyable. The
+// vector relocates such elements one by one, so this type measures the growth path used before the elements were
+// relocated in bulk.
+//
+struct PerElementVector3
+{
+    PerElementVector3(float in_x, float in_y, float in_z)
+        : x(in_x)
+        , y(in_y)
+        , z(in_z)
+    {}
+
+    PerElementVector3(const PerElementVector3& other)
+        : x(other.x)
+        , y(other.y)
+        , z(other.z)
+    {}
+
+    float x;
+    float y;
+    float z;
+};
+
+static_assert(is_trivially_relocatable<Vector3>);
+static_assert(!is_trivially_relocatable<PerElementVector3>);
+
+static constexpr u64 vector_add_element_count = 10'000'000;
+
+template<typename T>
+static u64 measure_vector_add(const char* case_name, bool reserve_capacity)
+{
+    return Benchmark::measure(case_name, vector_add_element_count, 0, [reserve_capacity]() {
+        Vector<T> elements;
+        if (reserve_capacity)
+            elements.ensure_capacity(vector_add_element_count);
+
+        for (u64 index = 0; index < vector_add_element_count; ++index)
+        {
+            const float value = static_cast<float>(index);
+            elements.add(T(value, value + 1.0F, value + 2.0F));
+        }
+        Benchmark::do_not_optimize(elements.elements());
+    });
+}
+
+CAVE_BENCHMARK(vector_add_vector3)
+{
+    Benchmark::begin_group("Vector::add, 10M elements, growing from an empty vector");
+    const u64 per_element_ticks = measure_vector_add<PerElementVector3>("before: per-element relocation", false);
+    const u64 bulk_ticks = measure_vector_add<Vector3>("after: bulk relocation (Vector3)", false);
+    Benchmark::report_speedup("speedup", per_element_ticks, bulk_ticks);
+
+    Benchmark::begin_group("Vector::add, 10M elements, capacity reserved up front");
+    const u64 reserved_per_element_ticks = measure_vector_add<PerElementVector3>("before: per-element relocation", true);
+    const u64 reserved_bulk_ticks = measure_vector_add<Vector3>("after: bulk relocation (Vector3)", true);
+    Benchmark::report_speedup("speedup", reserved_per_element_ticks, reserved_bulk_ticks);
+}
+
+} // namespace CaveGame
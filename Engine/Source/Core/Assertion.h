@@ -73,7 +73,7 @@ void report_assertion_failed(const char* expression, const char* filename, const
             CAVE_DEBUGBREAK;                                                                     \
         }
 #else
-    #define CAVE_ENABLE_DEBUG_ASSERTS(...)
+    #define CAVE_DEBUG_ASSERT(...)
 #endif // CAVE_ENABLE_DEBUG_ASSERTS
 
 #if CAVE_ENABLE_VERIFIES
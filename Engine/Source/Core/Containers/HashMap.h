@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/HashTable.h>
+
+namespace CaveGame
+{
+
+template<typename K, typename V>
+struct HashMapEntry
+{
+    K key;
+    V value;
+};
+
+//
+// Associative container that maps unique keys to values, stored in an open-addressing hash table.
+// This is our equivalent implementation of the `std::unordered_map` container, but the elements are stored in a flat
+// array, so inserting or removing elements invalidates all pointers to the keys and values stored in the map.
+//
+template<typename K, typename V, typename HasherType = Hasher<K>, typename AllocatorType = HeapAllocator>
+class HashMap
+{
+public:
+    using EntryType = HashMapEntry<K, V>;
+
+private:
+    struct Traits
+    {
+        using KeyType = K;
+        NODISCARD ALWAYS_INLINE static const K& get_key(const EntryType& entry) { return entry.key; }
+    };
+
+    using TableType = Detail::HashTable<EntryType, Traits, HasherType, AllocatorType>;
+
+public:
+    using Iterator = typename TableType::Iterator;
+    using ConstIterator = typename TableType::ConstIterator;
+
+public:
+    HashMap() = default;
+
+    ALWAYS_INLINE explicit HashMap(const AllocatorType& allocator)
+        : m_table(allocator)
+    {}
+
+public:
+    NODISCARD ALWAYS_INLINE usize capacity() const { return m_table.capacity(); }
+    NODISCARD ALWAYS_INLINE usize count() const { return m_table.count(); }
+
+    NODISCARD ALWAYS_INLINE bool is_empty() const { return m_table.is_empty(); }
+    NODISCARD ALWAYS_INLINE bool has_elements() const { return m_table.has_elements(); }
+
+public:
+    //
+    // Returns a pointer to the value associated with the given key, or nullptr if the key is not stored in the map.
+    // The pointer is invalidated when elements are inserted or removed.
+    //
+    template<typename LookupKeyType>
+    NODISCARD ALWAYS_INLINE V* find(const LookupKeyType& key)
+    {
+        const usize index = m_table.find_index(key);
+        if (index == TableType::invalid_index)
+            return nullptr;
+        return &m_table.slot_at(index).value;
+    }
+
+    //
+    // Returns a pointer to the value associated with the given key, or nullptr if the key is not stored in the map.
+    // The pointer is invalidated when elements are inserted or removed.
+    //
+    template<typename LookupKeyType>
+    NODISCARD ALWAYS_INLINE const V* find(const LookupKeyType& key) const
+    {
+        const usize index = m_table.find_index(key);
+        if (index == TableType::invalid_index)
+            return nullptr;
+        return &m_table.slot_at(index).value;
+    }
+
+    template<typename LookupKeyType>
+    NODISCARD ALWAYS_INLINE bool contains(const LookupKeyType& key) const
+    {
+        return (m_table.find_index(key) != TableType::invalid_index);
+    }
+
+    //
+    // Returns the value associated with the given key.
+    // If the key is not stored in the map, an assert will be triggered.
+    //
+    template<typename LookupKeyType>
+    NODISCARD ALWAYS_INLINE V& at(const LookupKeyType& key)
+    {
+        V* value = find(key);
+        CAVE_ASSERT(value != nullptr);
+        return *value;
+    }
+
+    //
+    // Returns the value associated with the given key.
+    // If the key is not stored in the map, an assert will be triggered.
+    //
+    template<typename LookupKeyType>
+    NODISCARD ALWAYS_INLINE const V& at(const LookupKeyType& key) const
+    {
+        const V* value = find(key);
+        CAVE_ASSERT(value != nullptr);
+        return *value;
+    }
+
+public:
+    //
+    // Associates the given value with the key. If the key is already stored in the map, its value is replaced.
+    // Returns true if the key has been inserted and false if the value of an existing key has been replaced.
+    //
+    template<typename ValueType>
+    ALWAYS_INLINE bool set(const K& key, ValueType&& value)
+    {
+        bool inserted;
+        const usize index = m_table.find_or_insert(
+            key, [&](void* slot) { new (slot) EntryType { key, forward<ValueType>(value) }; }, inserted);
+
+        if (!inserted)
+            m_table.slot_at(index).value = forward<ValueType>(value);
+        return inserted;
+    }
+
+    //
+    // Returns the value associated with the given key. If the key is not stored in the map, it is inserted and its value is
+    // constructed by forwarding the provided parameters to the value constructor.
+    //
+    template<typename... Args>
+    ALWAYS_INLINE V& get_or_add(const K& key, Args&&... args)
+    {
+        bool inserted;
+        const usize index = m_table.find_or_insert(
+            key, [&](void* slot) { new (slot) EntryType { key, V(forward<Args>(args)...) }; }, inserted);
+        return m_table.slot_at(index).value;
+    }
+
+    //
+    // Removes the key (and its value) from the map.
+    // Returns false if the key is not stored in the map.
+    //
+    template<typename LookupKeyType>
+    ALWAYS_INLINE bool remove(const LookupKeyType& key)
+    {
+        const usize index = m_table.find_index(key);
+        if (index == TableType::invalid_index)
+            return false;
+
+        m_table.remove_at(index);
+        return true;
+    }
+
+    // Removes all elements from the map without releasing the memory block.
+    ALWAYS_INLINE void clear() { m_table.clear(); }
+
+    // Removes all elements from the map and releases the memory block.
+    ALWAYS_INLINE void clear_and_shrink() { m_table.clear_and_shrink(); }
+
+    // Ensures that at least `in_count` elements can be stored without rehashing the map.
+    ALWAYS_INLINE void ensure_capacity(usize in_count) { m_table.ensure_capacity(in_count); }
+
+public:
+    NODISCARD ALWAYS_INLINE Iterator begin() { return m_table.begin(); }
+    NODISCARD ALWAYS_INLINE Iterator end() { return m_table.end(); }
+
+    NODISCARD ALWAYS_INLINE ConstIterator begin() const { return m_table.begin(); }
+    NODISCARD ALWAYS_INLINE ConstIterator end() const { return m_table.end(); }
+
+private:
+    TableType m_table;
+};
+
+} // namespace CaveGame
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/HashTable.h>
+
+namespace CaveGame
+{
+
+//
+// Container that stores a set of unique keys in an open-addressing hash table.
+// This is our equivalent implementation of the `std::unordered_set` container, but the keys are stored in a flat
+// array, so inserting or removing keys invalidates all pointers to the keys stored in the set.
+//
+template<typename K, typename HasherType = Hasher<K>, typename AllocatorType = HeapAllocator>
+class HashSet
+{
+private:
+    struct Traits
+    {
+        using KeyType = K;
+        NODISCARD ALWAYS_INLINE static const K& get_key(const K& key) { return key; }
+    };
+
+    using TableType = Detail::HashTable<K, Traits, HasherType, AllocatorType>;
+
+public:
+    // The keys must not be modified while they are stored in the set, so only constant iterators are provided.
+    using ConstIterator = typename TableType::ConstIterator;
+
+public:
+    HashSet() = default;
+
+    ALWAYS_INLINE explicit HashSet(const AllocatorType& allocator)
+        : m_table(allocator)
+    {}
+
+public:
+    NODISCARD ALWAYS_INLINE usize capacity() const { return m_table.capacity(); }
+    NODISCARD ALWAYS_INLINE usize count() const { return m_table.count(); }
+
+    NODISCARD ALWAYS_INLINE bool is_empty() const { return m_table.is_empty(); }
+    NODISCARD ALWAYS_INLINE bool has_elements() const { return m_table.has_elements(); }
+
+public:
+    template<typename LookupKeyType>
+    NODISCARD ALWAYS_INLINE bool contains(const LookupKeyType& key) const
+    {
+        return (m_table.find_index(key) != TableType::invalid_index);
+    }
+
+    //
+    // Inserts the key into the set.
+    // Returns false if the key is already stored in the set, in which case the set remains unchanged.
+    //
+    template<typename KeyType>
+    ALWAYS_INLINE bool add(KeyType&& key)
+    {
+        bool inserted;
+        m_table.find_or_insert(key, [&](void* slot) { new (slot) K(forward<KeyType>(key)); }, inserted);
+        return inserted;
+    }
+
+    //
+    // Removes the key from the set.
+    // Returns false if the key is not stored in the set.
+    //
+    template<typename LookupKeyType>
+    ALWAYS_INLINE bool remove(const LookupKeyType& key)
+    {
+        const usize index = m_table.find_index(key);
+        if (index == TableType::invalid_index)
+            return false;
+
+        m_table.remove_at(index);
+        return true;
+    }
+
+    // Removes all keys from the set without releasing the memory block.
+    ALWAYS_INLINE void clear() { m_table.clear(); }
+
+    // Removes all keys from the set and releases the memory block.
+    ALWAYS_INLINE void clear_and_shrink() { m_table.clear_and_shrink(); }
+
+    // Ensures that at least `in_count` keys can be stored without rehashing the set.
+    ALWAYS_INLINE void ensure_capacity(usize in_count) { m_table.ensure_capacity(in_count); }
+
+public:
+    NODISCARD ALWAYS_INLINE ConstIterator begin() const { return m_table.begin(); }
+    NODISCARD ALWAYS_INLINE ConstIterator end() const { return m_table.end(); }
+
+private:
+    TableType m_table;
+};
+
+} // namespace CaveGame
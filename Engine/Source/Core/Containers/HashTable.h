@@ -0,0 +1,500 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+#include <Core/Hash/Hash.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Memory/Allocators.h>
+#include <Core/Memory/MemoryOperations.h>
+
+#if CAVE_ARCHITECTURE_X64
+    #include <emmintrin.h>
+#endif // CAVE_ARCHITECTURE_X64
+
+namespace CaveGame
+{
+
+namespace Detail
+{
+
+//
+// Control byte values. A slot is either empty (the high bit is set) or full, in which case the control byte stores
+// the 7 high bits of the key hash. As no tombstones are used (see `HashTable::remove_at`), there are no other states.
+//
+static constexpr u8 hash_table_control_empty = 0x80;
+
+// The number of control bytes that are inspected at once when probing the table.
+static constexpr usize hash_table_group_width = 16;
+
+// The smallest capacity of an allocated table. Must be at least the group width, as the first control bytes are mirrored.
+static constexpr usize hash_table_min_capacity = 16;
+
+//
+// A group of consecutive control bytes, which can be queried for the slots that match a given hash or that are empty.
+// The queries return a bitmask, where the bit N corresponds to the N-th control byte of the group.
+//
+class HashTableControlGroup
+{
+public:
+#if CAVE_ARCHITECTURE_X64
+    ALWAYS_INLINE explicit HashTableControlGroup(const u8* control_bytes)
+        : m_control_bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control_bytes)))
+    {}
+
+    NODISCARD ALWAYS_INLINE u32 match(u8 hash_tag) const
+    {
+        const __m128i tags = _mm_set1_epi8(static_cast<char>(hash_tag));
+        return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_control_bytes, tags)));
+    }
+
+    // The empty control byte is the only one with the high bit set, so the sign mask of the bytes selects the empty slots.
+    NODISCARD ALWAYS_INLINE u32 match_empty() const { return static_cast<u32>(_mm_movemask_epi8(m_control_bytes)); }
+
+private:
+    __m128i m_control_bytes;
+#else
+    ALWAYS_INLINE explicit HashTableControlGroup(const u8* control_bytes)
+        : m_control_bytes(control_bytes)
+    {}
+
+    NODISCARD ALWAYS_INLINE u32 match(u8 hash_tag) const
+    {
+        u32 mask = 0;
+        for (usize index = 0; index < hash_table_group_width; ++index)
+            mask |= static_cast<u32>(m_control_bytes[index] == hash_tag) << index;
+        return mask;
+    }
+
+    NODISCARD ALWAYS_INLINE u32 match_empty() const { return match(hash_table_control_empty); }
+
+private:
+    const u8* m_control_bytes;
+#endif // CAVE_ARCHITECTURE_X64
+};
+
+//
+// Open-addressing hash table (in the style of the Swiss tables), which is the implementation of `HashMap` and `HashSet`.
+// The elements are stored in a flat array of slots and each slot has a matching control byte. Probing is linear and
+// inspects 16 control bytes at once, so a lookup typically compares only the keys whose 7-bit hash tag matches.
+//
+// The `Traits` type must provide the `KeyType` and a static `get_key(const T&)` function that returns the key of an element.
+//
+template<typename T, typename Traits, typename HasherType, typename AllocatorType>
+class HashTable
+{
+public:
+    using KeyType = typename Traits::KeyType;
+
+    // The maximum load factor of the table is 7/8.
+    static constexpr usize max_load_factor_numerator = 7;
+    static constexpr usize max_load_factor_denominator = 8;
+
+    static constexpr usize invalid_index = static_cast<usize>(-1);
+
+    template<typename TableType, typename ElementType>
+    class IteratorBase
+    {
+    public:
+        ALWAYS_INLINE IteratorBase(TableType* table, usize index)
+            : m_table(table)
+            , m_index(index)
+        {}
+
+        NODISCARD ALWAYS_INLINE ElementType& operator*() const { return m_table->m_slots[m_index]; }
+        NODISCARD ALWAYS_INLINE ElementType* operator->() const { return m_table->m_slots + m_index; }
+
+        NODISCARD ALWAYS_INLINE bool operator==(const IteratorBase& other) const { return (m_index == other.m_index); }
+        NODISCARD ALWAYS_INLINE bool operator!=(const IteratorBase& other) const { return (m_index != other.m_index); }
+
+        ALWAYS_INLINE IteratorBase& operator++()
+        {
+            m_index = m_table->find_next_full_index(m_index + 1);
+            return *this;
+        }
+
+    private:
+        TableType* m_table;
+        usize m_index;
+    };
+
+    using Iterator = IteratorBase<HashTable, T>;
+    using ConstIterator = IteratorBase<const HashTable, const T>;
+
+public:
+    ALWAYS_INLINE HashTable()
+        : m_slots(nullptr)
+        , m_control_bytes(nullptr)
+        , m_capacity(0)
+        , m_count(0)
+    {}
+
+    ALWAYS_INLINE explicit HashTable(const AllocatorType& allocator)
+        : m_slots(nullptr)
+        , m_control_bytes(nullptr)
+        , m_capacity(0)
+        , m_count(0)
+        , m_allocator(allocator)
+    {}
+
+    ALWAYS_INLINE HashTable(const HashTable& other)
+        : m_slots(nullptr)
+        , m_control_bytes(nullptr)
+        , m_capacity(0)
+        , m_count(0)
+        , m_allocator(other.m_allocator)
+    {
+        copy_elements_from(other);
+    }
+
+    ALWAYS_INLINE HashTable(HashTable&& other) noexcept
+        : m_slots(other.m_slots)
+        , m_control_bytes(other.m_control_bytes)
+        , m_capacity(other.m_capacity)
+        , m_count(other.m_count)
+        , m_allocator(other.m_allocator)
+    {
+        other.m_slots = nullptr;
+        other.m_control_bytes = nullptr;
+        other.m_capacity = 0;
+        other.m_count = 0;
+    }
+
+    ALWAYS_INLINE HashTable& operator=(const HashTable& other)
+    {
+        // Handle self-assignment case.
+        if (this == &other)
+            return *this;
+
+        clear();
+        copy_elements_from(other);
+        return *this;
+    }
+
+    ALWAYS_INLINE HashTable& operator=(HashTable&& other) noexcept
+    {
+        // Handle self-assignment case.
+        if (this == &other)
+            return *this;
+
+        clear_and_shrink();
+
+        // The memory block is now owned by this table, so it must be released using the allocator it was allocated with.
+        m_allocator = other.m_allocator;
+        m_slots = other.m_slots;
+        m_control_bytes = other.m_control_bytes;
+        m_capacity = other.m_capacity;
+        m_count = other.m_count;
+
+        other.m_slots = nullptr;
+        other.m_control_bytes = nullptr;
+        other.m_capacity = 0;
+        other.m_count = 0;
+
+        return *this;
+    }
+
+    ALWAYS_INLINE ~HashTable()
+    {
+        // Destroy the elements and release the memory.
+        clear_and_shrink();
+    }
+
+public:
+    NODISCARD ALWAYS_INLINE usize capacity() const { return m_capacity; }
+    NODISCARD ALWAYS_INLINE usize count() const { return m_count; }
+
+    NODISCARD ALWAYS_INLINE bool is_empty() const { return (m_count == 0); }
+    NODISCARD ALWAYS_INLINE bool has_elements() const { return (m_count > 0); }
+
+public:
+    //
+    // Returns the index of the slot that stores the element with the given key, or `invalid_index` if no such element exists.
+    // The lookup key can be of any type that the hasher can hash and that can be compared with the key type, as long as
+    // equal keys produce equal hashes.
+    //
+    template<typename LookupKeyType>
+    NODISCARD usize find_index(const LookupKeyType& key) const
+    {
+        if (m_count == 0)
+            return invalid_index;
+        return find_index_with_hash(key, HasherType::hash(key));
+    }
+
+    //
+    // Finds the slot that stores the element with the given key or, if no such element exists, constructs a new element
+    // by invoking `construct_element(void* slot)`. Returns the index of the slot and whether or not the element was inserted.
+    //
+    template<typename LookupKeyType, typename ConstructFunction>
+    ALWAYS_INLINE usize find_or_insert(const LookupKeyType& key, ConstructFunction construct_element, bool& out_inserted)
+    {
+        // NOTE: The key is hashed only once, as the same hash is used to probe for the existing element and to insert
+        // the new one.
+        const u64 hash = HasherType::hash(key);
+        if (m_count > 0)
+        {
+            const usize existing_index = find_index_with_hash(key, hash);
+            if (existing_index != invalid_index)
+            {
+                out_inserted = false;
+                return existing_index;
+            }
+        }
+
+        ensure_capacity(m_count + 1);
+        const usize index = find_empty_index(hash);
+
+        construct_element(static_cast<void*>(m_slots + index));
+        set_control_byte(index, get_hash_tag(hash));
+        ++m_count;
+
+        out_inserted = true;
+        return index;
+    }
+
+    //
+    // Destroys the element stored in the given slot.
+    //
+    // Instead of marking the slot with a tombstone, the elements that follow it in the same probe run are shifted back
+    // into the freed slot (when their probe sequence allows it). This keeps the invariant that no element is stored
+    // after an empty slot in its probe sequence, so lookups can stop at the first empty slot and the table never
+    // degrades after many removals.
+    //
+    void remove_at(usize index)
+    {
+        CAVE_ASSERT(index < m_capacity && is_full(index));
+        m_slots[index].~T();
+        --m_count;
+
+        const usize index_mask = m_capacity - 1;
+        usize free_index = index;
+        for (usize current_index = (index + 1) & index_mask; is_full(current_index); current_index = (current_index + 1) & index_mask)
+        {
+            const usize home_index = static_cast<usize>(HasherType::hash(Traits::get_key(m_slots[current_index]))) & index_mask;
+
+            // The element can be shifted into the free slot only if the free slot is located between the element's
+            // home slot and the slot it currently occupies (taking the wrap-around into account).
+            const usize distance_from_home = (current_index - home_index) & index_mask;
+            const usize distance_from_free = (current_index - free_index) & index_mask;
+            if (distance_from_home >= distance_from_free)
+            {
+                relocate_element(m_slots + free_index, m_slots + current_index);
+                set_control_byte(free_index, m_control_bytes[current_index]);
+                free_index = current_index;
+            }
+        }
+
+        set_control_byte(free_index, hash_table_control_empty);
+    }
+
+    //
+    // Destroys all elements stored in the table without releasing the memory block,
+    // thus the capacity of the table will remain unchanged.
+    //
+    void clear()
+    {
+        if (m_count == 0)
+            return;
+
+        if constexpr (!is_trivially_destructible<T>)
+        {
+            for (usize index = 0; index < m_capacity; ++index)
+            {
+                if (is_full(index))
+                    m_slots[index].~T();
+            }
+        }
+
+        for (usize index = 0; index < get_control_byte_count(m_capacity); ++index)
+            m_control_bytes[index] = hash_table_control_empty;
+        m_count = 0;
+    }
+
+    //
+    // Destroys the elements stored in the table and releases the memory block.
+    // The capacity of the table will be zero.
+    //
+    void clear_and_shrink()
+    {
+        clear();
+
+        if (m_slots)
+            m_allocator.release(m_slots, get_allocation_size(m_capacity), get_allocation_alignment());
+        m_slots = nullptr;
+        m_control_bytes = nullptr;
+        m_capacity = 0;
+    }
+
+    //
+    // Ensures that at least `in_count` elements can be stored without rehashing the table.
+    // The capacity of the table is always a power of two.
+    //
+    void ensure_capacity(usize in_count)
+    {
+        if (in_count * max_load_factor_denominator <= m_capacity * max_load_factor_numerator)
+            return;
+
+        usize new_capacity = (m_capacity > 0) ? (m_capacity * 2) : hash_table_min_capacity;
+        while (in_count * max_load_factor_denominator > new_capacity * max_load_factor_numerator)
+            new_capacity *= 2;
+
+        rehash(new_capacity);
+    }
+
+public:
+    NODISCARD ALWAYS_INLINE T& slot_at(usize index) { return m_slots[index]; }
+    NODISCARD ALWAYS_INLINE const T& slot_at(usize index) const { return m_slots[index]; }
+
+    NODISCARD ALWAYS_INLINE Iterator begin() { return Iterator(this, find_next_full_index(0)); }
+    NODISCARD ALWAYS_INLINE Iterator end() { return Iterator(this, m_capacity); }
+
+    NODISCARD ALWAYS_INLINE ConstIterator begin() const { return ConstIterator(this, find_next_full_index(0)); }
+    NODISCARD ALWAYS_INLINE ConstIterator end() const { return ConstIterator(this, m_capacity); }
+
+private:
+    // The 7 high bits of the hash, which are stored in the control byte of a full slot.
+    NODISCARD ALWAYS_INLINE static u8 get_hash_tag(u64 hash) { return static_cast<u8>(hash >> 57); }
+
+    //
+    // The control bytes of the first `group_width - 1` slots are mirrored after the last control byte, so that a group
+    // can always be loaded with a single unaligned load, even when it wraps around the end of the table.
+    //
+    NODISCARD ALWAYS_INLINE static usize get_control_byte_count(usize in_capacity) { return in_capacity + hash_table_group_width - 1; }
+
+    // The slots and the control bytes are stored in a single memory block, with the control bytes after the slots.
+    NODISCARD ALWAYS_INLINE static usize get_allocation_size(usize in_capacity) { return in_capacity * sizeof(T) + get_control_byte_count(in_capacity); }
+    NODISCARD ALWAYS_INLINE static usize get_allocation_alignment() { return alignof(T); }
+
+    NODISCARD ALWAYS_INLINE bool is_full(usize index) const { return (m_control_bytes[index] & hash_table_control_empty) == 0; }
+
+    ALWAYS_INLINE void set_control_byte(usize index, u8 control_byte)
+    {
+        m_control_bytes[index] = control_byte;
+        if (index < hash_table_group_width - 1)
+            m_control_bytes[m_capacity + index] = control_byte;
+    }
+
+    NODISCARD ALWAYS_INLINE usize find_next_full_index(usize index) const
+    {
+        while (index < m_capacity && !is_full(index))
+            ++index;
+        return index;
+    }
+
+    // Returns the index of the slot that stores the element with the given key and hash, or `invalid_index` if no such
+    // element exists. The table must have a non-zero capacity.
+    template<typename LookupKeyType>
+    NODISCARD usize find_index_with_hash(const LookupKeyType& key, u64 hash) const
+    {
+        const u8 hash_tag = get_hash_tag(hash);
+        const usize index_mask = m_capacity - 1;
+        usize group_index = static_cast<usize>(hash) & index_mask;
+
+        for (usize probed_count = 0; probed_count < m_capacity; probed_count += hash_table_group_width)
+        {
+            const HashTableControlGroup group = HashTableControlGroup(m_control_bytes + group_index);
+            for (u32 match_mask = group.match(hash_tag); match_mask != 0; match_mask &= match_mask - 1)
+            {
+                const usize index = (group_index + Math::count_trailing_zeros(match_mask)) & index_mask;
+                if (Traits::get_key(m_slots[index]) == key)
+                    return index;
+            }
+
+            // The elements are never stored after an empty slot in their probe sequence.
+            if (group.match_empty() != 0)
+                return invalid_index;
+
+            group_index = (group_index + hash_table_group_width) & index_mask;
+        }
+
+        return invalid_index;
+    }
+
+    // Returns the index of the first empty slot in the probe sequence of the given hash. The table must not be full.
+    NODISCARD ALWAYS_INLINE usize find_empty_index(u64 hash) const
+    {
+        const usize index_mask = m_capacity - 1;
+        usize group_index = static_cast<usize>(hash) & index_mask;
+        while (true)
+        {
+            const u32 empty_mask = HashTableControlGroup(m_control_bytes + group_index).match_empty();
+            if (empty_mask != 0)
+                return (group_index + Math::count_trailing_zeros(empty_mask)) & index_mask;
+            group_index = (group_index + hash_table_group_width) & index_mask;
+        }
+    }
+
+    // Moves the element stored at `source` to `destination` and destroys the source element.
+    ALWAYS_INLINE static void relocate_element(T* destination, T* source)
+    {
+        if constexpr (is_trivially_relocatable<T>)
+        {
+            copy_memory(destination, source, sizeof(T));
+        }
+        else
+        {
+            new (destination) T(move(*source));
+            source->~T();
+        }
+    }
+
+    void rehash(usize new_capacity)
+    {
+        CAVE_ASSERT(new_capacity >= hash_table_min_capacity && (new_capacity & (new_capacity - 1)) == 0);
+
+        T* old_slots = m_slots;
+        u8* old_control_bytes = m_control_bytes;
+        const usize old_capacity = m_capacity;
+
+        void* memory_block = m_allocator.allocate(get_allocation_size(new_capacity), get_allocation_alignment());
+        m_slots = static_cast<T*>(memory_block);
+        m_control_bytes = static_cast<u8*>(memory_block) + new_capacity * sizeof(T);
+        m_capacity = new_capacity;
+        set_memory(m_control_bytes, hash_table_control_empty, get_control_byte_count(new_capacity));
+
+        for (usize old_index = 0; old_index < old_capacity; ++old_index)
+        {
+            if ((old_control_bytes[old_index] & hash_table_control_empty) != 0)
+                continue;
+
+            const u64 hash = HasherType::hash(Traits::get_key(old_slots[old_index]));
+            const usize new_index = find_empty_index(hash);
+            relocate_element(m_slots + new_index, old_slots + old_index);
+            set_control_byte(new_index, get_hash_tag(hash));
+        }
+
+        if (old_slots)
+            m_allocator.release(old_slots, get_allocation_size(old_capacity), get_allocation_alignment());
+    }
+
+    void copy_elements_from(const HashTable& other)
+    {
+        ensure_capacity(other.m_count);
+        for (const T& element : other)
+        {
+            const u64 hash = HasherType::hash(Traits::get_key(element));
+            const usize index = find_empty_index(hash);
+            new (m_slots + index) T(element);
+            set_control_byte(index, get_hash_tag(hash));
+            ++m_count;
+        }
+    }
+
+private:
+    T* m_slots;
+    u8* m_control_bytes;
+    usize m_capacity;
+    usize m_count;
+    NO_UNIQUE_ADDRESS AllocatorType m_allocator;
+};
+
+} // namespace Detail
+
+} // namespace CaveGame
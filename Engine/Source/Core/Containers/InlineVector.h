@@ -0,0 +1,415 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/Containers/VectorCommon.h>
+#include <Core/CoreTypes.h>
+#include <Core/Memory/Allocators.h>
+
+namespace CaveGame
+{
+
+//
+// Container that stores a contiguos array of elements, just like `Vector`, but which stores up to `InlineCapacity`
+// elements inside the container itself. The memory block is only allocated (using the `AllocatorType`) when the
+// number of elements exceeds the inline capacity, which makes it ideal for small lists that are frequently created.
+// The API is identical to the `Vector` API, so the two containers can be used interchangeably.
+//
+// NOTE: Unlike `Vector`, moving the container is an O(n) operation while the elements are stored inline.
+//
+template<typename T, usize InlineCapacity, typename AllocatorType = HeapAllocator>
+class InlineVector
+{
+public:
+    static_assert(InlineCapacity > 0, "Use Vector if no elements should be stored inline.");
+
+    using Iterator = T*;
+    using ConstIterator = const T*;
+
+public:
+    ALWAYS_INLINE InlineVector()
+        : m_elements(inline_elements())
+        , m_capacity(InlineCapacity)
+        , m_count(0)
+    {}
+
+    ALWAYS_INLINE explicit InlineVector(const AllocatorType& allocator)
+        : m_elements(inline_elements())
+        , m_capacity(InlineCapacity)
+        , m_count(0)
+        , m_allocator(allocator)
+    {}
+
+    ALWAYS_INLINE InlineVector(const InlineVector& other)
+        : m_elements(inline_elements())
+        , m_capacity(InlineCapacity)
+        , m_count(0)
+        , m_allocator(other.m_allocator)
+    {
+        ensure_capacity(other.m_count);
+        Detail::copy_vector_elements(m_elements, other.m_elements, other.m_count);
+        m_count = other.m_count;
+    }
+
+    ALWAYS_INLINE InlineVector(InlineVector&& other) noexcept
+        : m_elements(inline_elements())
+        , m_capacity(InlineCapacity)
+        , m_count(0)
+        , m_allocator(other.m_allocator)
+    {
+        take_elements_from(other);
+    }
+
+    ALWAYS_INLINE InlineVector& operator=(const InlineVector& other)
+    {
+        // Handle self-assignment case.
+        if (this == &other)
+            return *this;
+
+        clear();
+        ensure_capacity(other.m_count);
+        Detail::copy_vector_elements(m_elements, other.m_elements, other.m_count);
+        m_count = other.m_count;
+        return *this;
+    }
+
+    ALWAYS_INLINE InlineVector& operator=(InlineVector&& other) noexcept
+    {
+        // Handle self-assignment case.
+        if (this == &other)
+            return *this;
+
+        clear_and_shrink();
+
+        // The memory block (if any) is now owned by this vector, so it must be released using the allocator it was allocated with.
+        m_allocator = other.m_allocator;
+        take_elements_from(other);
+        return *this;
+    }
+
+    ALWAYS_INLINE ~InlineVector()
+    {
+        // Destroy the elements and release the memory.
+        clear_and_shrink();
+    }
+
+public:
+    NODISCARD ALWAYS_INLINE T* elements() { return m_elements; }
+    NODISCARD ALWAYS_INLINE const T* elements() const { return m_elements; }
+
+    NODISCARD ALWAYS_INLINE usize capacity() const { return m_capacity; }
+    NODISCARD ALWAYS_INLINE usize count() const { return m_count; }
+
+    NODISCARD ALWAYS_INLINE bool is_empty() const { return (m_count == 0); }
+    NODISCARD ALWAYS_INLINE bool has_elements() const { return (m_count > 0); }
+
+    // Returns whether or not the elements are currently stored inside the container (no memory block is allocated).
+    NODISCARD ALWAYS_INLINE bool is_inline() const { return (m_elements == inline_elements()); }
+
+    NODISCARD ALWAYS_INLINE AllocatorType& allocator() { return m_allocator; }
+    NODISCARD ALWAYS_INLINE const AllocatorType& allocator() const { return m_allocator; }
+
+public:
+    //
+    // Returns the element stored at the given index in the internal array.
+    // If the index is out of bounds, an assert will be triggered.
+    //
+    NODISCARD ALWAYS_INLINE T& at(usize index)
+    {
+        CAVE_ASSERT(index < m_count);
+        return m_elements[index];
+    }
+
+    //
+    // Returns the element stored at the given index in the internal array.
+    // If the index is out of bounds, an assert will be triggered.
+    //
+    NODISCARD ALWAYS_INLINE const T& at(usize index) const
+    {
+        CAVE_ASSERT(index < m_count);
+        return m_elements[index];
+    }
+
+    // Direct wrappers around the `InlineVector::at()` API.
+    NODISCARD ALWAYS_INLINE T& operator[](usize index) { return at(index); }
+    NODISCARD ALWAYS_INLINE const T& operator[](usize index) const { return at(index); }
+
+    //
+    // Returns the first element stored in the internal array.
+    // If the container is empty, an assert will be triggered.
+    //
+    NODISCARD ALWAYS_INLINE T& first()
+    {
+        CAVE_ASSERT(has_elements());
+        return m_elements[0];
+    }
+
+    //
+    // Returns the first element stored in the internal array.
+    // If the container is empty, an assert will be triggered.
+    //
+    NODISCARD ALWAYS_INLINE const T& first() const
+    {
+        CAVE_ASSERT(has_elements());
+        return m_elements[0];
+    }
+
+    //
+    // Returns the last element stored in the internal array.
+    // If the container is empty, an assert will be triggered.
+    //
+    NODISCARD ALWAYS_INLINE T& last()
+    {
+        CAVE_ASSERT(has_elements());
+        return m_elements[m_count - 1];
+    }
+
+    //
+    // Returns the last element stored in the internal array.
+    // If the container is empty, an assert will be triggered.
+    //
+    NODISCARD ALWAYS_INLINE const T& last() const
+    {
+        CAVE_ASSERT(has_elements());
+        return m_elements[m_count - 1];
+    }
+
+public:
+    //
+    // Constructs a new element at the end of the internal array by forwarding the provided
+    // parameters to the object constructor.
+    // If the internal array is not big enough to store another element the container will expand.
+    //
+    template<typename... Args>
+    ALWAYS_INLINE void emplace(Args&&... args)
+    {
+        ensure_capacity(m_count + 1);
+        new (m_elements + m_count) T(forward<Args>(args)...);
+        ++m_count;
+    }
+
+    // Wrappers around `InlineVector::emplace`.
+    ALWAYS_INLINE void add(const T& element) { emplace(element); }
+    ALWAYS_INLINE void add(T&& element) { emplace(move(element)); }
+
+public:
+    //
+    // Destroys all elements stored in the container without releasing the internal memory block,
+    // thus the capacity of the vector will remain unchanged.
+    //
+    ALWAYS_INLINE void clear()
+    {
+        Detail::destroy_vector_elements(m_elements, m_count);
+        m_count = 0;
+    }
+
+    //
+    // Destroys the elements stored in the container and releases the internal memory block.
+    // The capacity of the vector will be the inline capacity.
+    //
+    ALWAYS_INLINE void clear_and_shrink()
+    {
+        clear();
+
+        if (!is_inline())
+        {
+            release_memory(m_elements, m_capacity);
+            m_elements = inline_elements();
+            m_capacity = InlineCapacity;
+        }
+    }
+
+    //
+    // Shrinks the vector internal memory block such that it will have the capacity to store exactly
+    // the number of elements currently held by the container. If the elements fit in the inline storage,
+    // they are moved back inside the container and the memory block is released.
+    //
+    ALWAYS_INLINE void shrink_to_fit()
+    {
+        if (is_inline() || m_count == m_capacity)
+            return;
+
+        T* new_elements = (m_count <= InlineCapacity) ? inline_elements() : allocate_memory(m_count);
+        Detail::move_vector_elements(new_elements, m_elements, m_count);
+
+        release_memory(m_elements, m_capacity);
+        m_elements = new_elements;
+        m_capacity = is_inline() ? InlineCapacity : m_count;
+    }
+
+public:
+    // Ensures that at least `in_capacity` elements can be stored without expanding the memory block.
+    // The actual capacity *is not* guaranteed to be `in_capacity` after calling this function.
+    ALWAYS_INLINE void ensure_capacity(usize in_capacity)
+    {
+        if (m_capacity >= in_capacity)
+            return;
+
+        const usize new_capacity = Detail::calculate_next_vector_capacity(in_capacity, m_capacity);
+        if (try_expand_memory_in_place(new_capacity))
+            return;
+
+        T* new_elements = allocate_memory(new_capacity);
+        Detail::move_vector_elements(new_elements, m_elements, m_count);
+
+        if (!is_inline())
+            release_memory(m_elements, m_capacity);
+        m_elements = new_elements;
+        m_capacity = new_capacity;
+    }
+
+    // Ensures that at least `in_capacity` elements can be stored without expanding the memory block.
+    // The actual capacity is guaranteed to be `in_capacity` after calling this function, unless `in_capacity`
+    // is less than the inline capacity (in which case the elements are stored inline).
+    ALWAYS_INLINE void set_capacity(usize in_capacity)
+    {
+        if (m_capacity == in_capacity)
+            return;
+
+        CAVE_ASSERT(in_capacity >= m_count);
+        if (in_capacity <= InlineCapacity)
+        {
+            if (is_inline())
+                return;
+
+            Detail::move_vector_elements(inline_elements(), m_elements, m_count);
+            release_memory(m_elements, m_capacity);
+            m_elements = inline_elements();
+            m_capacity = InlineCapacity;
+            return;
+        }
+
+        if (in_capacity > m_capacity && try_expand_memory_in_place(in_capacity))
+            return;
+
+        T* new_elements = allocate_memory(in_capacity);
+        Detail::move_vector_elements(new_elements, m_elements, m_count);
+
+        if (!is_inline())
+            release_memory(m_elements, m_capacity);
+        m_elements = new_elements;
+        m_capacity = in_capacity;
+    }
+
+    // Sets the number of elements currently stored in the container. If the new count is greater than
+    // the current count, the new elements are not initialized in any way.
+    ALWAYS_INLINE void set_count_uninitialized(usize in_count)
+    {
+        if (in_count == m_count)
+            return;
+
+        ensure_capacity(in_count);
+
+        // If the new count is less than the current count the last `m_count - in_count` elements must be destroyed.
+        if (in_count < m_count)
+            Detail::destroy_vector_elements(m_elements + in_count, m_count - in_count);
+
+        m_count = in_count;
+    }
+
+    // Sets the number of elements currently stored in the container. If the new count is greater than
+    // the current count, the new elements are initialized using the default constructor.
+    ALWAYS_INLINE void set_count_defaulted(usize in_count)
+    {
+        const usize current_count = m_count;
+        set_count_uninitialized(in_count);
+
+        for (usize index = current_count; index < m_count; ++index)
+            new (m_elements + index) T();
+    }
+
+    // Sets the number of elements currently stored in the container. If the new count is greater than
+    // the current count, the new elements are initialized using the copy constructor and the provided `constructor_element`.
+    ALWAYS_INLINE void set_count(usize in_count, const T& constructor_element)
+    {
+        const usize current_count = m_count;
+        set_count_uninitialized(in_count);
+
+        for (usize index = current_count; index < m_count; ++index)
+            new (m_elements + index) T(constructor_element);
+    }
+
+public:
+    NODISCARD ALWAYS_INLINE Iterator begin() { return Iterator(m_elements); }
+    NODISCARD ALWAYS_INLINE Iterator end() { return Iterator(m_elements + m_count); }
+
+    NODISCARD ALWAYS_INLINE ConstIterator begin() const { return ConstIterator(m_elements); }
+    NODISCARD ALWAYS_INLINE ConstIterator end() const { return ConstIterator(m_elements + m_count); }
+
+private:
+    NODISCARD ALWAYS_INLINE T* inline_elements() { return reinterpret_cast<T*>(m_inline_storage); }
+    NODISCARD ALWAYS_INLINE const T* inline_elements() const { return reinterpret_cast<const T*>(m_inline_storage); }
+
+    //
+    // Takes the elements stored in the `other` vector, which is left empty. If the other vector stores its elements
+    // inline they must be moved one by one, otherwise the memory block is simply stolen.
+    // This vector must be empty and store its elements inline when calling this function.
+    //
+    ALWAYS_INLINE void take_elements_from(InlineVector& other)
+    {
+        if (other.is_inline())
+        {
+            Detail::move_vector_elements(m_elements, other.m_elements, other.m_count);
+            m_count = other.m_count;
+            other.m_count = 0;
+            return;
+        }
+
+        m_elements = other.m_elements;
+        m_capacity = other.m_capacity;
+        m_count = other.m_count;
+
+        other.m_elements = other.inline_elements();
+        other.m_capacity = InlineCapacity;
+        other.m_count = 0;
+    }
+
+    // Allocates a memory block large enough to store `in_capacity` elements.
+    NODISCARD ALWAYS_INLINE T* allocate_memory(usize in_capacity)
+    {
+        const usize allocation_size = in_capacity * sizeof(T);
+        void* memory_block = m_allocator.allocate(allocation_size, alignof(T));
+        return static_cast<T*>(memory_block);
+    }
+
+    // Releases a memory block large enough to store `in_capacity` elements located at address `in_elements`.
+    ALWAYS_INLINE void release_memory(T* in_elements, usize in_capacity)
+    {
+        const usize allocation_size = in_capacity * sizeof(T);
+        m_allocator.release(in_elements, allocation_size, alignof(T));
+    }
+
+    //
+    // Tries to grow the current memory block such that it can store `in_capacity` elements, without moving the elements.
+    // Returns false if the allocator can't grow the block in place or if the elements are stored inline.
+    //
+    NODISCARD ALWAYS_INLINE bool try_expand_memory_in_place(usize in_capacity)
+    {
+        if (is_inline())
+            return false;
+
+        const usize old_allocation_size = m_capacity * sizeof(T);
+        const usize new_allocation_size = in_capacity * sizeof(T);
+        if (!m_allocator.try_expand_in_place(m_elements, old_allocation_size, new_allocation_size))
+            return false;
+
+        m_capacity = in_capacity;
+        return true;
+    }
+
+private:
+    T* m_elements;
+    usize m_capacity;
+    usize m_count;
+    NO_UNIQUE_ADDRESS AllocatorType m_allocator;
+    alignas(T) u8 m_inline_storage[InlineCapacity * sizeof(T)];
+};
+
+} // namespace CaveGame
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+#include <atomic>
+#include <new>
+
+namespace CaveGame
+{
+
+//
+// Bounded lock-free queue with any number of producer and consumer threads, as described by Dmitry Vyukov
+// ("Bounded MPMC queue").
+//
+// Each cell stores a sequence number next to the element, which tells the threads in which state the cell is:
+//   - equal to the position of a producer: the cell is free and the producer can claim it.
+//   - equal to the position of a consumer plus one: the cell holds an element and the consumer can claim it.
+// A thread claims a position by advancing the enqueue (or dequeue) position with a single CAS and then publishes the
+// new state of the cell by storing its sequence number, so the producers and the consumers never contend with each
+// other, only among themselves.
+//
+// The capacity must be a power of two. The elements are stored inline, so large queues should be heap-allocated.
+//
+template<typename T, u32 Capacity>
+class MPMCQueue
+{
+    static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "The capacity must be a power of two, larger than one!");
+
+    CAVE_MAKE_NONCOPYABLE(MPMCQueue);
+    CAVE_MAKE_NONMOVABLE(MPMCQueue);
+
+public:
+    MPMCQueue()
+    {
+        for (u32 cell_index = 0; cell_index < Capacity; ++cell_index)
+            m_cells[cell_index].sequence.store(cell_index, std::memory_order_relaxed);
+    }
+
+    // NOTE: No thread may access the queue while it is destroyed.
+    ~MPMCQueue()
+    {
+        const u64 enqueue_position = m_enqueue_position.load(std::memory_order_acquire);
+        for (u64 position = m_dequeue_position.load(std::memory_order_relaxed); position < enqueue_position; ++position)
+            m_cells[position & position_mask].get_element()->~T();
+    }
+
+    NODISCARD ALWAYS_INLINE static constexpr u32 capacity() { return Capacity; }
+
+public:
+    //
+    // Pushes an element at the back of the queue. Returns false if the queue is full, in which case the element is left
+    // untouched. Can be called by any thread.
+    //
+    template<typename ElementType>
+    NODISCARD bool try_push(ElementType&& element)
+    {
+        u64 position = m_enqueue_position.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &m_cells[position & position_mask];
+            const u64 sequence = cell->sequence.load(std::memory_order_acquire);
+            const i64 difference = static_cast<i64>(sequence) - static_cast<i64>(position);
+
+            if (difference == 0)
+            {
+                // The cell is free. Claim it, unless another producer has claimed it first.
+                if (m_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                // The cell still holds the element pushed one lap ago, so the queue is full.
+                return false;
+            }
+            else
+            {
+                // Another producer has already claimed the position.
+                position = m_enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        ::new (cell->get_element()) T(forward<ElementType>(element));
+        // Publish the element to the consumers.
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    //
+    // Pops the element at the front of the queue, by moving it into `out_element`. Returns false if the queue is empty.
+    // Can be called by any thread.
+    //
+    NODISCARD bool try_pop(T& out_element)
+    {
+        u64 position = m_dequeue_position.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &m_cells[position & position_mask];
+            const u64 sequence = cell->sequence.load(std::memory_order_acquire);
+            const i64 difference = static_cast<i64>(sequence) - static_cast<i64>(position + 1);
+
+            if (difference == 0)
+            {
+                // The cell holds an element. Claim it, unless another consumer has claimed it first.
+                if (m_dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                // The element for this position hasn't been pushed yet, so the queue is empty.
+                return false;
+            }
+            else
+            {
+                // Another consumer has already claimed the position.
+                position = m_dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* element = cell->get_element();
+        out_element = move(*element);
+        element->~T();
+        // Return the cell to the producers, for the position one lap ahead.
+        cell->sequence.store(position + Capacity, std::memory_order_release);
+        return true;
+    }
+
+    // Returns the approximate number of elements stored in the queue.
+    NODISCARD ALWAYS_INLINE usize approximate_count() const
+    {
+        const u64 dequeue_position = m_dequeue_position.load(std::memory_order_relaxed);
+        const u64 enqueue_position = m_enqueue_position.load(std::memory_order_relaxed);
+        return (enqueue_position > dequeue_position) ? static_cast<usize>(enqueue_position - dequeue_position) : 0;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<u64> sequence;
+        alignas(T) u8 element_storage[sizeof(T)];
+
+        NODISCARD ALWAYS_INLINE T* get_element() { return reinterpret_cast<T*>(element_storage); }
+    };
+
+    static constexpr u64 position_mask = static_cast<u64>(Capacity) - 1;
+
+private:
+    // NOTE: The positions are placed on separate cache lines, as one is written by the producers and the other one
+    // by the consumers.
+    alignas(64) std::atomic<u64> m_enqueue_position { 0 };
+    alignas(64) std::atomic<u64> m_dequeue_position { 0 };
+    alignas(64) Cell m_cells[Capacity];
+};
+
+} // namespace CaveGame
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Assertion.h>
+#include <Core/Containers/Name.h>
+#include <Core/Memory/MemoryOperations.h>
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace CaveGame
+{
+
+//
+// The name table is split into shards, selected by the high bits of the string hash, so that threads interning
+// different strings rarely contend on the same lock. Each shard owns an open-addressing table that maps the string
+// hashes to name indices, and the memory blocks where the characters of its names are stored.
+//
+static constexpr u32 name_table_shard_count_log2 = 4;
+static constexpr u32 name_table_shard_count = 1 << name_table_shard_count_log2;
+
+// The initial capacity of a shard table. The capacities are always powers of two and the maximum load factor is 1/2.
+static constexpr u32 name_shard_table_initial_capacity = 256;
+
+// The characters of the names are stored in memory blocks of this size. Longer names are stored in dedicated blocks.
+static constexpr usize name_entry_block_byte_count = 64 * KiB;
+
+//
+// The indices are mapped to the name entries using a two-level table, with chunks that are allocated on demand.
+// As the chunks never move, an index can be resolved without taking any lock.
+//
+static constexpr u32 name_index_chunk_entry_count_log2 = 12;
+static constexpr u32 name_index_chunk_entry_count = 1 << name_index_chunk_entry_count_log2;
+static constexpr u32 name_index_max_chunk_count = 4096;
+
+//
+// The header of an interned string. The null-terminated characters are stored immediately after the header.
+//
+struct NameEntry
+{
+    u64 hash;
+    u32 byte_count;
+
+    NODISCARD ALWAYS_INLINE const char* characters() const { return reinterpret_cast<const char*>(this + 1); }
+    NODISCARD ALWAYS_INLINE char* characters() { return reinterpret_cast<char*>(this + 1); }
+};
+
+//
+// A slot of a shard table stores the high 32 bits of the string hash and the name index, so most mismatches are
+// rejected without dereferencing the entry. A zero slot is empty (the index zero is never stored in the table).
+//
+struct NameShardTable
+{
+    u32 capacity;
+    std::atomic<u64>* slots;
+
+    // The tables replaced by a bigger one are kept alive, as other threads might still be reading them.
+    NameShardTable* previous_table;
+};
+
+// The header of a memory block in which the name entries are stored.
+struct NameEntryBlock
+{
+    NameEntryBlock* next_block;
+};
+
+struct NameShard
+{
+    std::mutex mutex;
+    std::atomic<NameShardTable*> table { nullptr };
+
+    // The following fields are only accessed while the mutex is locked.
+    u32 count { 0 };
+    NameEntryBlock* blocks { nullptr };
+    u8* block_cursor { nullptr };
+    usize block_remaining_byte_count { 0 };
+};
+
+class NameTable
+{
+    CAVE_MAKE_NONCOPYABLE(NameTable);
+    CAVE_MAKE_NONMOVABLE(NameTable);
+
+public:
+    NameTable() = default;
+    ~NameTable();
+
+    NODISCARD u32 find(StringView view) const;
+    NODISCARD u32 intern(StringView view);
+
+    NODISCARD const NameEntry* get_entry(u32 index) const;
+
+private:
+    NODISCARD const NameEntry* find_entry_in_table(const NameShardTable* table, u64 hash, StringView view, u32& out_index) const;
+    void insert_into_table(NameShardTable* table, u64 hash, u32 index);
+    NODISCARD NameShardTable* grow_table(NameShard& shard);
+
+    NODISCARD NameEntry* allocate_entry(NameShard& shard, StringView view, u64 hash);
+    void publish_entry(u32 index, const NameEntry* entry);
+
+private:
+    NameShard m_shards[name_table_shard_count];
+    std::atomic<std::atomic<const NameEntry*>*> m_index_chunks[name_index_max_chunk_count] {};
+
+    // The index zero is reserved for the empty name.
+    std::atomic<u32> m_next_index { 1 };
+};
+
+NameTable::~NameTable()
+{
+    for (NameShard& shard : m_shards)
+    {
+        NameShardTable* table = shard.table.load(std::memory_order_relaxed);
+        while (table)
+        {
+            NameShardTable* previous_table = table->previous_table;
+            delete[] table->slots;
+            delete table;
+            table = previous_table;
+        }
+
+        NameEntryBlock* block = shard.blocks;
+        while (block)
+        {
+            NameEntryBlock* next_block = block->next_block;
+            ::operator delete(block);
+            block = next_block;
+        }
+    }
+
+    for (std::atomic<std::atomic<const NameEntry*>*>& chunk : m_index_chunks)
+        delete[] chunk.load(std::memory_order_relaxed);
+}
+
+u32 NameTable::find(StringView view) const
+{
+    if (view.is_empty())
+        return 0;
+
+    const u64 hash = Hash::string(view.characters(), view.byte_count());
+    const NameShard& shard = m_shards[hash >> (64 - name_table_shard_count_log2)];
+
+    u32 index;
+    if (!find_entry_in_table(shard.table.load(std::memory_order_acquire), hash, view, index))
+        return 0;
+    return index;
+}
+
+u32 NameTable::intern(StringView view)
+{
+    if (view.is_empty())
+        return 0;
+
+    const u64 hash = Hash::string(view.characters(), view.byte_count());
+    NameShard& shard = m_shards[hash >> (64 - name_table_shard_count_log2)];
+
+    // Fast path: the string has already been interned, so no lock has to be taken.
+    u32 index = 0;
+    if (find_entry_in_table(shard.table.load(std::memory_order_acquire), hash, view, index))
+        return index;
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // Another thread might have interned the string while the lock was being acquired.
+    NameShardTable* table = shard.table.load(std::memory_order_relaxed);
+    if (find_entry_in_table(table, hash, view, index))
+        return index;
+
+    if (!table || (shard.count + 1) * 2 > table->capacity)
+        table = grow_table(shard);
+
+    index = m_next_index.fetch_add(1, std::memory_order_relaxed);
+    // The name table has been exhausted.
+    CAVE_ASSERT(index < name_index_max_chunk_count * name_index_chunk_entry_count);
+
+    // The entry must be reachable through its index before the index is published in the shard table.
+    const NameEntry* entry = allocate_entry(shard, view, hash);
+    publish_entry(index, entry);
+    insert_into_table(table, hash, index);
+    ++shard.count;
+
+    return index;
+}
+
+const NameEntry* NameTable::get_entry(u32 index) const
+{
+    const u32 chunk_index = index >> name_index_chunk_entry_count_log2;
+    CAVE_ASSERT(chunk_index < name_index_max_chunk_count);
+
+    const std::atomic<const NameEntry*>* chunk = m_index_chunks[chunk_index].load(std::memory_order_acquire);
+    CAVE_ASSERT(chunk);
+
+    const NameEntry* entry = chunk[index & (name_index_chunk_entry_count - 1)].load(std::memory_order_acquire);
+    CAVE_ASSERT(entry);
+    return entry;
+}
+
+const NameEntry* NameTable::find_entry_in_table(const NameShardTable* table, u64 hash, StringView view, u32& out_index) const
+{
+    if (!table)
+        return nullptr;
+
+    const u32 hash_tag = static_cast<u32>(hash >> 32);
+    const u32 index_mask = table->capacity - 1;
+
+    for (u32 slot_index = static_cast<u32>(hash) & index_mask;; slot_index = (slot_index + 1) & index_mask)
+    {
+        const u64 slot = table->slots[slot_index].load(std::memory_order_acquire);
+        if (slot == 0)
+            return nullptr;
+        if (static_cast<u32>(slot >> 32) != hash_tag)
+            continue;
+
+        const u32 index = static_cast<u32>(slot);
+        const NameEntry* entry = get_entry(index);
+        if (entry->byte_count == view.byte_count() && memory_equals(entry->characters(), view.characters(), view.byte_count()))
+        {
+            out_index = index;
+            return entry;
+        }
+    }
+}
+
+void NameTable::insert_into_table(NameShardTable* table, u64 hash, u32 index)
+{
+    const u32 index_mask = table->capacity - 1;
+    u32 slot_index = static_cast<u32>(hash) & index_mask;
+    while (table->slots[slot_index].load(std::memory_order_relaxed) != 0)
+        slot_index = (slot_index + 1) & index_mask;
+
+    const u64 slot = (static_cast<u64>(hash >> 32) << 32) | index;
+    table->slots[slot_index].store(slot, std::memory_order_release);
+}
+
+NameShardTable* NameTable::grow_table(NameShard& shard)
+{
+    NameShardTable* old_table = shard.table.load(std::memory_order_relaxed);
+
+    NameShardTable* new_table = new NameShardTable();
+    new_table->capacity = old_table ? (old_table->capacity * 2) : name_shard_table_initial_capacity;
+    new_table->slots = new std::atomic<u64>[new_table->capacity];
+    new_table->previous_table = old_table;
+    for (u32 slot_index = 0; slot_index < new_table->capacity; ++slot_index)
+        new_table->slots[slot_index].store(0, std::memory_order_relaxed);
+
+    if (old_table)
+    {
+        for (u32 slot_index = 0; slot_index < old_table->capacity; ++slot_index)
+        {
+            const u64 slot = old_table->slots[slot_index].load(std::memory_order_relaxed);
+            if (slot != 0)
+                insert_into_table(new_table, get_entry(static_cast<u32>(slot))->hash, static_cast<u32>(slot));
+        }
+    }
+
+    // Readers that still use the old table will either find the names they are looking for or fall back to the locked path.
+    shard.table.store(new_table, std::memory_order_release);
+    return new_table;
+}
+
+NameEntry* NameTable::allocate_entry(NameShard& shard, StringView view, u64 hash)
+{
+    const usize entry_byte_count = (sizeof(NameEntry) + view.byte_count() + 1 + alignof(NameEntry) - 1) & ~(alignof(NameEntry) - 1);
+    constexpr usize block_header_byte_count = (sizeof(NameEntryBlock) + alignof(NameEntry) - 1) & ~(alignof(NameEntry) - 1);
+
+    u8* entry_address;
+    if (entry_byte_count > name_entry_block_byte_count / 4)
+    {
+        // Long names are stored in dedicated blocks, so that they don't waste the remaining space of the current block.
+        NameEntryBlock* block = static_cast<NameEntryBlock*>(::operator new(block_header_byte_count + entry_byte_count));
+        block->next_block = shard.blocks;
+        shard.blocks = block;
+        entry_address = reinterpret_cast<u8*>(block) + block_header_byte_count;
+    }
+    else
+    {
+        if (entry_byte_count > shard.block_remaining_byte_count)
+        {
+            NameEntryBlock* block = static_cast<NameEntryBlock*>(::operator new(name_entry_block_byte_count));
+            block->next_block = shard.blocks;
+            shard.blocks = block;
+            shard.block_cursor = reinterpret_cast<u8*>(block) + block_header_byte_count;
+            shard.block_remaining_byte_count = name_entry_block_byte_count - block_header_byte_count;
+        }
+
+        entry_address = shard.block_cursor;
+        shard.block_cursor += entry_byte_count;
+        shard.block_remaining_byte_count -= entry_byte_count;
+    }
+
+    NameEntry* entry = new (entry_address) NameEntry();
+    entry->hash = hash;
+    entry->byte_count = static_cast<u32>(view.byte_count());
+    copy_memory(entry->characters(), view.characters(), view.byte_count());
+    entry->characters()[view.byte_count()] = 0;
+    return entry;
+}
+
+void NameTable::publish_entry(u32 index, const NameEntry* entry)
+{
+    std::atomic<std::atomic<const NameEntry*>*>& chunk_pointer = m_index_chunks[index >> name_index_chunk_entry_count_log2];
+
+    std::atomic<const NameEntry*>* chunk = chunk_pointer.load(std::memory_order_acquire);
+    if (!chunk)
+    {
+        // The chunks are shared between all shards, so multiple threads might try to allocate the same chunk.
+        std::atomic<const NameEntry*>* new_chunk = new std::atomic<const NameEntry*>[name_index_chunk_entry_count];
+        for (u32 entry_index = 0; entry_index < name_index_chunk_entry_count; ++entry_index)
+            new_chunk[entry_index].store(nullptr, std::memory_order_relaxed);
+
+        if (chunk_pointer.compare_exchange_strong(chunk, new_chunk, std::memory_order_acq_rel, std::memory_order_acquire))
+            chunk = new_chunk;
+        else
+            delete[] new_chunk;
+    }
+
+    chunk[index & (name_index_chunk_entry_count - 1)].store(entry, std::memory_order_release);
+}
+
+// The name table is created the first time it is used, so names can be safely created during static initialization.
+static NameTable& get_name_table()
+{
+    // NOTE: The table is never destroyed, so names can also be used during (or after) static destruction.
+    static NameTable* s_name_table = new NameTable();
+    return *s_name_table;
+}
+
+Name::Name(StringView view)
+    : m_index(get_name_table().intern(view))
+{}
+
+Name Name::find(StringView view)
+{
+    Name name;
+    name.m_index = get_name_table().find(view);
+    return name;
+}
+
+StringView Name::view() const
+{
+    if (m_index == 0)
+        return ""sv;
+
+    const NameEntry* entry = get_name_table().get_entry(m_index);
+    return StringView::create_from_utf8(entry->characters(), entry->byte_count);
+}
+
+} // namespace CaveGame
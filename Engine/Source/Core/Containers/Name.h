@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/StringView.h>
+#include <Core/CoreTypes.h>
+#include <Core/Hash/Hash.h>
+
+namespace CaveGame
+{
+
+//
+// An interned, immutable UTF-8 string, represented by a 32-bit index into the global name table.
+//
+// Every distinct string is stored exactly once in the table and is never released, so two names are equal if and
+// only if their indices are equal. This makes comparing, hashing and copying names as cheap as for an integer,
+// which is ideal for identifiers such as block type names, asset paths and configuration keys.
+//
+// Creating a name from a string that has already been interned doesn't take any lock, so names can be created
+// from any thread. The empty string is always represented by the index zero, which is also the default value.
+//
+class Name
+{
+public:
+    ALWAYS_INLINE constexpr Name()
+        : m_index(0)
+    {}
+
+    // Interns the given string (if it hasn't been already) and returns its name.
+    explicit Name(StringView view);
+
+    //
+    // Returns the name of the given string, only if it has already been interned. Otherwise, the empty name is returned.
+    // Useful when looking up identifiers provided by the user, as it never grows the name table.
+    //
+    NODISCARD static Name find(StringView view);
+
+public:
+    NODISCARD ALWAYS_INLINE u32 index() const { return m_index; }
+    NODISCARD ALWAYS_INLINE bool is_empty() const { return (m_index == 0); }
+
+    //
+    // Returns the characters of the name. The view remains valid for the lifetime of the program and the
+    // characters are null-terminated, so `view().characters()` can be passed to C APIs.
+    //
+    NODISCARD StringView view() const;
+
+    // The index is unique for each name, so mixing it produces a well-distributed hash.
+    NODISCARD ALWAYS_INLINE u64 hash() const { return Hash::integer(static_cast<u64>(m_index)); }
+
+public:
+    NODISCARD ALWAYS_INLINE bool operator==(Name other) const { return (m_index == other.m_index); }
+    NODISCARD ALWAYS_INLINE bool operator!=(Name other) const { return (m_index != other.m_index); }
+
+private:
+    u32 m_index;
+};
+
+template<>
+struct Hasher<Name>
+{
+    NODISCARD ALWAYS_INLINE static u64 hash(Name name) { return name.hash(); }
+};
+
+} // namespace CaveGame
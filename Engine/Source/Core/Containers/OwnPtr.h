@@ -139,6 +139,10 @@ private:
     T* m_instance;
 };
 
+// An owning pointer only stores the address of the instance, so it can be relocated by copying its bytes.
+template<typename T>
+constexpr bool is_trivially_relocatable<OwnPtr<T>> = true;
+
 template<typename T>
 NODISCARD ALWAYS_INLINE OwnPtr<T> adopt_own(T* raw_instance)
 {
@@ -10,28 +10,127 @@
 
 #include <Core/Assertion.h>
 #include <Core/CoreTypes.h>
+#include <Core/Memory/ReferenceCount.h>
 
 namespace CaveGame
 {
 
+template<typename ReferenceCountType>
+class RefCountedBase;
+
+namespace Detail
+{
+
+//
+// Control block shared by a reference counted object and all the weak pointers that reference it. It is allocated the
+// first time a weak pointer to the object is created, so objects that are never weakly referenced don't pay for it.
+//
+// The object holds a weak reference to the control block while it is alive, so the control block outlives both the
+// object and all weak pointers. Taking a strong reference through the control block and detaching the object (when its
+// last strong reference is released) are serialized by a spin lock, which is only contended by these two operations.
+//
+class WeakReferenceControlBlock
+{
+    CAVE_MAKE_NONCOPYABLE(WeakReferenceControlBlock);
+    CAVE_MAKE_NONMOVABLE(WeakReferenceControlBlock);
+
+public:
+    ALWAYS_INLINE explicit WeakReferenceControlBlock(RefCountedBase<AtomicReferenceCount>* object)
+        : m_object(object)
+        , m_weak_reference_count(1)
+    {}
+
+    ALWAYS_INLINE void increment_weak_reference_count() { m_weak_reference_count.increment(); }
+
+    // Releases a weak reference and deletes the control block if it was the last one.
+    ALWAYS_INLINE void release_weak_reference()
+    {
+        if (m_weak_reference_count.decrement())
+            delete this;
+    }
+
+    // NOTE: The object might be destroyed right after this function returns true, so it should only be used as a hint.
+    NODISCARD ALWAYS_INLINE bool is_object_alive() const { return (m_object.load(std::memory_order_acquire) != nullptr); }
+
+    //
+    // Takes a strong reference to the object, if it is still alive. Returns the object (whose reference count has already
+    // been incremented) or nullptr if the object has been (or is being) destroyed.
+    //
+    NODISCARD RefCountedBase<AtomicReferenceCount>* try_take_strong_reference();
+
+    //
+    // Invoked when the last strong reference to the object has been released. After this function returns no new strong
+    // references can be taken, so the object can be safely destroyed.
+    //
+    void detach_object();
+
+private:
+    ALWAYS_INLINE void lock()
+    {
+        while (m_is_locked.exchange(true, std::memory_order_acquire))
+        {
+            while (m_is_locked.load(std::memory_order_relaxed))
+                ;
+        }
+    }
+
+    ALWAYS_INLINE void unlock() { m_is_locked.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<RefCountedBase<AtomicReferenceCount>*> m_object;
+    std::atomic<bool> m_is_locked { false };
+    AtomicReferenceCount m_weak_reference_count;
+};
+
+//
+// Stores the pointer to the weak reference control block of a reference counted object. Only the objects with an atomic
+// reference count can be weakly referenced, so the storage is empty (and occupies no space) for all the other ones.
+//
+template<typename ReferenceCountType>
+struct WeakReferenceControlBlockStorage
+{};
+
+template<>
+struct WeakReferenceControlBlockStorage<AtomicReferenceCount>
+{
+    // Allocated when the first weak pointer to the object is created.
+    std::atomic<WeakReferenceControlBlock*> control_block { nullptr };
+};
+
+} // namespace Detail
+
 //
 // Base class for all types that are intended to be managed by a RefPtr.
 // Holds the object's reference count intrusively and manages the increment/decrement operations.
+// The `ReferenceCountType` determines whether or not the references can be shared across threads.
 //
-class RefCounted
+template<typename ReferenceCountType>
+class RefCountedBase
 {
     template<typename T>
     friend class RefPtr;
 
+    template<typename T>
+    friend class WeakPtr;
+
+    friend class Detail::WeakReferenceControlBlock;
+
 public:
-    ALWAYS_INLINE RefCounted()
-        : m_reference_count(0)
-    {}
+    RefCountedBase() = default;
+
+    virtual ~RefCountedBase()
+    {
+        // The object is usually detached when its last reference is released. This handles the objects that are
+        // destroyed without being managed by a RefPtr.
+        detach_weak_references();
+    }
 
-    virtual ~RefCounted() = default;
+    // NOTE: The reference count belongs to the instance, so it is never copied.
+    ALWAYS_INLINE RefCountedBase(const RefCountedBase&) {}
+    ALWAYS_INLINE RefCountedBase& operator=(const RefCountedBase&) { return *this; }
 
 private:
-    ALWAYS_INLINE void increment_reference_count() { ++m_reference_count; }
+    ALWAYS_INLINE void increment_reference_count() { m_reference_count.increment(); }
 
     //
     // Returns true if the reference count hits zero after the decrement operation, signaling
@@ -39,20 +138,92 @@ private:
     //
     NODISCARD ALWAYS_INLINE bool decrement_reference_count()
     {
-        // Decrementing the reference count of an instance that should have been deleted is not valid.
-        CAVE_DEBUG_ASSERT(m_reference_count > 0);
+        if (!m_reference_count.decrement())
+            return false;
 
-        --m_reference_count;
-        return (m_reference_count == 0);
+        // No new strong references can be taken through the weak pointers once the object starts being destroyed.
+        detach_weak_references();
+        return true;
+    }
+
+    //
+    // Returns the weak reference control block of the object, creating it if needed, with an additional weak reference
+    // taken on behalf of the caller. The caller must hold a strong reference to the object.
+    //
+    NODISCARD Detail::WeakReferenceControlBlock* acquire_weak_control_block()
+    {
+        static_assert(is_same<ReferenceCountType, AtomicReferenceCount>, "Only RefCounted objects can be weakly referenced!");
+
+        Detail::WeakReferenceControlBlock* control_block = m_weak_control_block.control_block.load(std::memory_order_acquire);
+        if (!control_block)
+        {
+            // Multiple threads might try to create the control block at the same time, but only one will succeed.
+            Detail::WeakReferenceControlBlock* new_control_block = new Detail::WeakReferenceControlBlock(this);
+            if (m_weak_control_block.control_block.compare_exchange_strong(control_block, new_control_block, std::memory_order_acq_rel, std::memory_order_acquire))
+                control_block = new_control_block;
+            else
+                delete new_control_block;
+        }
+
+        control_block->increment_weak_reference_count();
+        return control_block;
+    }
+
+    ALWAYS_INLINE void detach_weak_references()
+    {
+        if constexpr (is_same<ReferenceCountType, AtomicReferenceCount>)
+        {
+            Detail::WeakReferenceControlBlock* control_block = m_weak_control_block.control_block.load(std::memory_order_acquire);
+            if (control_block)
+            {
+                control_block->detach_object();
+                m_weak_control_block.control_block.store(nullptr, std::memory_order_relaxed);
+            }
+        }
     }
 
 private:
-    u32 m_reference_count;
+    ReferenceCountType m_reference_count;
+    NO_UNIQUE_ADDRESS Detail::WeakReferenceControlBlockStorage<ReferenceCountType> m_weak_control_block;
 };
 
+//
+// The default base class for reference counted types. The references can be safely taken and released from any thread,
+// but each `RefPtr` instance must still be accessed by a single thread at a time.
+//
+using RefCounted = RefCountedBase<AtomicReferenceCount>;
+
+//
+// Base class for reference counted types that are only ever referenced from a single thread. Taking and releasing
+// references is cheaper, as no atomic read-modify-write instructions are needed.
+//
+using RefCountedNonAtomic = RefCountedBase<NonAtomicReferenceCount>;
+
+inline RefCountedBase<AtomicReferenceCount>* Detail::WeakReferenceControlBlock::try_take_strong_reference()
+{
+    lock();
+    RefCountedBase<AtomicReferenceCount>* object = m_object.load(std::memory_order_relaxed);
+    // The reference count can be zero if the last strong reference has been released, but the object hasn't been detached yet.
+    if (object && !object->m_reference_count.try_increment_if_not_zero())
+        object = nullptr;
+    unlock();
+    return object;
+}
+
+inline void Detail::WeakReferenceControlBlock::detach_object()
+{
+    lock();
+    m_object.store(nullptr, std::memory_order_release);
+    unlock();
+
+    // Release the weak reference held by the object.
+    release_weak_reference();
+}
+
 //
 // Container that manages the lifetime of an intrusive reference counted object instance.
-// The provided template parameter type must be derived from `RefCounted`, otherwise a static assert will be issued.
+// The provided template parameter type must be derived from `RefCounted` or `RefCountedNonAtomic`, otherwise a
+// static assert will be issued.
 //
 template<typename T>
 class RefPtr
@@ -63,6 +234,9 @@ class RefPtr
     template<typename Q>
     friend RefPtr<Q> adopt_ref(Q* raw_instance);
 
+    template<typename Q>
+    friend class WeakPtr;
+
 public:
     ALWAYS_INLINE RefPtr()
         : m_instance(nullptr)
@@ -201,24 +375,36 @@ private:
             increment_reference_count();
     }
 
+    // Tag used to construct a RefPtr from an instance whose reference count has already been incremented.
+    struct AlreadyReferencedTag
+    {};
+
+    ALWAYS_INLINE RefPtr(T* raw_instance, AlreadyReferencedTag)
+        : m_instance(raw_instance)
+    {}
+
+    static constexpr bool is_ref_counted = is_derived_from<T, RefCounted> || is_derived_from<T, RefCountedNonAtomic>;
+
     ALWAYS_INLINE void increment_reference_count()
     {
-        static_assert(is_derived_from<T, RefCounted>, "T must be derived from RefCounted!");
-        RefCounted* ref_counted = static_cast<RefCounted*>(m_instance);
-        ref_counted->increment_reference_count();
+        static_assert(is_ref_counted, "T must be derived from RefCounted or RefCountedNonAtomic!");
+        m_instance->increment_reference_count();
     }
 
     NODISCARD ALWAYS_INLINE bool decrement_reference_count()
     {
-        static_assert(is_derived_from<T, RefCounted>, "T must be derived from RefCounted!");
-        RefCounted* ref_counted = static_cast<RefCounted*>(m_instance);
-        return ref_counted->decrement_reference_count();
+        static_assert(is_ref_counted, "T must be derived from RefCounted or RefCountedNonAtomic!");
+        return m_instance->decrement_reference_count();
     }
 
 private:
     T* m_instance;
 };
 
+// A reference-counted pointer only stores the address of the instance, so it can be relocated by copying its bytes.
+template<typename T>
+constexpr bool is_trivially_relocatable<RefPtr<T>> = true;
+
 template<typename T>
 NODISCARD ALWAYS_INLINE RefPtr<T> adopt_ref(T* raw_instance)
 {
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+#include <atomic>
+#include <new>
+
+namespace CaveGame
+{
+
+//
+// Bounded lock-free queue with a single producer thread and a single consumer thread.
+//
+// The producer only writes the write index and the consumer only writes the read index, so pushing and popping never
+// need a read-modify-write operation. Each index is stored on its own cache line, together with the copy of the other
+// index last seen by its thread. The other index is only read again (which moves its cache line between the cores)
+// when the cached copy suggests that the buffer is full (for the producer) or empty (for the consumer).
+//
+// The batch operations publish all their elements with a single store, which makes them much cheaper per element.
+//
+// The capacity must be a power of two. The elements are stored inline, so large buffers should be heap-allocated.
+//
+template<typename T, u32 Capacity>
+class SPSCRingBuffer
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "The capacity must be a power of two!");
+
+    CAVE_MAKE_NONCOPYABLE(SPSCRingBuffer);
+    CAVE_MAKE_NONMOVABLE(SPSCRingBuffer);
+
+public:
+    SPSCRingBuffer() = default;
+
+    // NOTE: No thread may access the buffer while it is destroyed.
+    ~SPSCRingBuffer()
+    {
+        const u64 write_index = m_write_index.load(std::memory_order_acquire);
+        for (u64 index = m_read_index.load(std::memory_order_relaxed); index < write_index; ++index)
+            get_slot(index)->~T();
+    }
+
+    NODISCARD ALWAYS_INLINE static constexpr u32 capacity() { return Capacity; }
+
+public:
+    //
+    // Pushes an element at the back of the buffer. Returns false if the buffer is full, in which case the element is
+    // left untouched. Can only be called by the producer thread.
+    //
+    template<typename ElementType>
+    NODISCARD ALWAYS_INLINE bool try_push(ElementType&& element)
+    {
+        const u64 write_index = m_write_index.load(std::memory_order_relaxed);
+        if (write_index - m_producer_cached_read_index >= Capacity)
+        {
+            m_producer_cached_read_index = m_read_index.load(std::memory_order_acquire);
+            if (write_index - m_producer_cached_read_index >= Capacity)
+                return false;
+        }
+
+        ::new (get_slot(write_index)) T(forward<ElementType>(element));
+        // Publish the element to the consumer.
+        m_write_index.store(write_index + 1, std::memory_order_release);
+        return true;
+    }
+
+    //
+    // Pops the element at the front of the buffer, by moving it into `out_element`. Returns false if the buffer is empty.
+    // Can only be called by the consumer thread.
+    //
+    NODISCARD ALWAYS_INLINE bool try_pop(T& out_element)
+    {
+        const u64 read_index = m_read_index.load(std::memory_order_relaxed);
+        if (read_index == m_consumer_cached_write_index)
+        {
+            m_consumer_cached_write_index = m_write_index.load(std::memory_order_acquire);
+            if (read_index == m_consumer_cached_write_index)
+                return false;
+        }
+
+        T* slot = get_slot(read_index);
+        out_element = move(*slot);
+        slot->~T();
+        // Return the slot to the producer.
+        m_read_index.store(read_index + 1, std::memory_order_release);
+        return true;
+    }
+
+    //
+    // Pushes (copies) as many of the given elements as there is space for, in order, and returns how many were pushed.
+    // Can only be called by the producer thread.
+    //
+    NODISCARD u32 push_batch(const T* elements, u32 element_count)
+    {
+        const u64 write_index = m_write_index.load(std::memory_order_relaxed);
+        u64 free_slot_count = Capacity - (write_index - m_producer_cached_read_index);
+        if (free_slot_count < element_count)
+        {
+            m_producer_cached_read_index = m_read_index.load(std::memory_order_acquire);
+            free_slot_count = Capacity - (write_index - m_producer_cached_read_index);
+        }
+
+        const u32 push_count = (free_slot_count < element_count) ? static_cast<u32>(free_slot_count) : element_count;
+        for (u32 element_index = 0; element_index < push_count; ++element_index)
+            ::new (get_slot(write_index + element_index)) T(elements[element_index]);
+
+        if (push_count > 0)
+            m_write_index.store(write_index + push_count, std::memory_order_release);
+        return push_count;
+    }
+
+    //
+    // Pops (moves) up to `max_element_count` elements into the given array, in order, and returns how many were popped.
+    // Can only be called by the consumer thread.
+    //
+    NODISCARD u32 pop_batch(T* out_elements, u32 max_element_count)
+    {
+        const u64 read_index = m_read_index.load(std::memory_order_relaxed);
+        u64 available_count = m_consumer_cached_write_index - read_index;
+        if (available_count < max_element_count)
+        {
+            m_consumer_cached_write_index = m_write_index.load(std::memory_order_acquire);
+            available_count = m_consumer_cached_write_index - read_index;
+        }
+
+        const u32 pop_count = (available_count < max_element_count) ? static_cast<u32>(available_count) : max_element_count;
+        for (u32 element_index = 0; element_index < pop_count; ++element_index)
+        {
+            T* slot = get_slot(read_index + element_index);
+            out_elements[element_index] = move(*slot);
+            slot->~T();
+        }
+
+        if (pop_count > 0)
+            m_read_index.store(read_index + pop_count, std::memory_order_release);
+        return pop_count;
+    }
+
+    //
+    // Returns the approximate number of elements stored in the buffer. The count is exact when the producer or the
+    // consumer calls it while the other thread is idle.
+    //
+    NODISCARD ALWAYS_INLINE usize approximate_count() const
+    {
+        const u64 read_index = m_read_index.load(std::memory_order_relaxed);
+        const u64 write_index = m_write_index.load(std::memory_order_relaxed);
+        return (write_index > read_index) ? static_cast<usize>(write_index - read_index) : 0;
+    }
+
+private:
+    static constexpr u64 index_mask = static_cast<u64>(Capacity) - 1;
+    static constexpr usize storage_alignment = (alignof(T) > 64) ? alignof(T) : 64;
+
+    NODISCARD ALWAYS_INLINE T* get_slot(u64 index) { return reinterpret_cast<T*>(m_storage) + (index & index_mask); }
+
+private:
+    //
+    // NOTE: The indices increase monotonically and are wrapped into the storage by masking. A 64-bit index never
+    // overflows in practice, so the number of stored elements is always the difference between the indices.
+    //
+    alignas(64) std::atomic<u64> m_write_index { 0 };
+    u64 m_producer_cached_read_index { 0 };
+
+    alignas(64) std::atomic<u64> m_read_index { 0 };
+    u64 m_consumer_cached_write_index { 0 };
+
+    alignas(storage_alignment) u8 m_storage[Capacity * sizeof(T)];
+};
+
+} // namespace CaveGame
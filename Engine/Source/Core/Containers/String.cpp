@@ -14,53 +14,40 @@ namespace CaveGame
 {
 
 String::String()
-    : m_byte_count(1)
 {
-    m_inline_buffer[0] = 0;
+    set_empty();
 }
 
 String::String(const String& other)
-    : m_byte_count(other.m_byte_count)
 {
-    if (is_stored_inline())
-    {
-        copy_memory(m_inline_buffer, other.m_inline_buffer, m_byte_count);
-    }
-    else
+    // NOTE: Copying all bytes copies both the inline buffer and the heap storage (including the tag byte).
+    copy_memory(m_inline_buffer, other.m_inline_buffer, inline_capacity);
+    if (!is_stored_inline())
     {
-        m_heap_buffer = other.m_heap_buffer;
-        CAVE_ASSERT(m_heap_buffer);
-        m_heap_buffer->reference_count++;
+        CAVE_ASSERT(m_heap.buffer);
+        m_heap.buffer->reference_count.increment();
     }
 }
 
 String::String(String&& other) noexcept
-    : m_byte_count(other.m_byte_count)
 {
-    if (is_stored_inline())
-        copy_memory(m_inline_buffer, other.m_inline_buffer, m_byte_count);
-    else
-        m_heap_buffer = other.m_heap_buffer;
-
-    other.m_heap_buffer = nullptr;
-    zero_memory(other.m_inline_buffer, inline_capacity);
-    other.m_byte_count = 1;
+    copy_memory(m_inline_buffer, other.m_inline_buffer, inline_capacity);
+    other.set_empty();
 }
 
 String::String(StringView view)
-    : m_byte_count(view.byte_count() + 1)
 {
-    if (is_stored_inline())
+    const usize byte_count = view.byte_count() + 1;
+    if (byte_count <= inline_capacity)
     {
-        copy_memory(m_inline_buffer, view.characters(), view.byte_count());
-        m_inline_buffer[m_byte_count - 1] = 0;
+        set_inline(view.characters(), byte_count);
     }
     else
     {
-        m_heap_buffer = allocate_heap_buffer(m_byte_count);
-        m_heap_buffer->reference_count = 1;
-        copy_memory(m_heap_buffer->characters, view.characters(), view.byte_count());
-        m_heap_buffer->characters[m_byte_count - 1] = 0;
+        HeapBuffer* heap_buffer = allocate_heap_buffer(byte_count);
+        copy_memory(heap_buffer->characters, view.characters(), view.byte_count());
+        heap_buffer->characters[byte_count - 1] = 0;
+        set_heap(heap_buffer, byte_count);
     }
 }
 
@@ -72,16 +59,11 @@ String& String::operator=(const String& other)
 
     clear();
 
-    m_byte_count = other.m_byte_count;
-    if (is_stored_inline())
-    {
-        copy_memory(m_inline_buffer, other.m_inline_buffer, m_byte_count);
-    }
-    else
+    copy_memory(m_inline_buffer, other.m_inline_buffer, inline_capacity);
+    if (!is_stored_inline())
     {
-        m_heap_buffer = other.m_heap_buffer;
-        CAVE_ASSERT(m_heap_buffer);
-        m_heap_buffer->reference_count++;
+        CAVE_ASSERT(m_heap.buffer);
+        m_heap.buffer->reference_count.increment();
     }
 
     return *this;
@@ -95,37 +77,17 @@ String& String::operator=(String&& other) noexcept
 
     clear();
 
-    m_byte_count = other.m_byte_count;
-    if (is_stored_inline())
-        copy_memory(m_inline_buffer, other.m_inline_buffer, m_byte_count);
-    else
-        m_heap_buffer = other.m_heap_buffer;
-
-    other.m_heap_buffer = nullptr;
-    zero_memory(other.m_inline_buffer, inline_capacity);
-    other.m_byte_count = 1;
+    copy_memory(m_inline_buffer, other.m_inline_buffer, inline_capacity);
+    other.set_empty();
 
     return *this;
 }
 
 String& String::operator=(StringView view)
 {
-    clear();
-
-    m_byte_count = view.byte_count() + 1;
-    if (is_stored_inline())
-    {
-        copy_memory(m_inline_buffer, view.characters(), view.byte_count());
-        m_inline_buffer[m_byte_count - 1] = 0;
-    }
-    else
-    {
-        m_heap_buffer = allocate_heap_buffer(m_byte_count);
-        m_heap_buffer->reference_count = 1;
-        copy_memory(m_heap_buffer->characters, view.characters(), view.byte_count());
-        m_heap_buffer->characters[m_byte_count - 1] = 0;
-    }
-
+    // NOTE: The view might reference the characters of this string, so it must be copied before the string is cleared.
+    String new_string = String(view);
+    *this = move(new_string);
     return *this;
 }
 
@@ -134,24 +96,55 @@ String::~String()
     clear();
 }
 
-void String::clear()
+u64 String::hash() const
 {
     if (is_stored_inline())
+        return Hash::string(m_inline_buffer, byte_count() - 1);
+
+    CAVE_ASSERT(m_heap.buffer);
+    u64 hash = m_heap.buffer->hash.load(std::memory_order_relaxed);
+    if (hash == 0)
     {
-        zero_memory(m_inline_buffer, m_byte_count);
+        hash = Hash::string(m_heap.buffer->characters, m_heap.byte_count - 1);
+        m_heap.buffer->hash.store(hash, std::memory_order_relaxed);
     }
-    else
-    {
-        CAVE_ASSERT(m_heap_buffer);
-        m_heap_buffer->reference_count--;
-        if (m_heap_buffer->reference_count == 0)
-            release_heap_buffer(m_heap_buffer, m_byte_count);
+    return hash;
+}
 
-        m_heap_buffer = nullptr;
+void String::clear()
+{
+    if (!is_stored_inline())
+    {
+        CAVE_ASSERT(m_heap.buffer);
+        if (m_heap.buffer->reference_count.decrement())
+            release_heap_buffer(m_heap.buffer, m_heap.byte_count);
     }
 
-    m_byte_count = 1;
+    set_empty();
+}
+
+void String::set_inline(const char* characters, usize byte_count)
+{
+    CAVE_ASSERT(byte_count >= 1 && byte_count <= inline_capacity);
+    copy_memory(m_inline_buffer, characters, byte_count - 1);
+    m_inline_buffer[byte_count - 1] = 0;
+
+    // When the inline buffer is full, the tag byte is the null terminator written above (both are zero).
+    m_inline_buffer[inline_capacity - 1] = static_cast<char>(inline_capacity - byte_count);
+}
+
+void String::set_heap(HeapBuffer* heap_buffer, usize byte_count)
+{
+    CAVE_ASSERT(byte_count > inline_capacity);
+    m_heap.buffer = heap_buffer;
+    m_heap.byte_count = byte_count;
+    m_heap.tag = heap_tag;
+}
+
+void String::set_empty()
+{
     m_inline_buffer[0] = 0;
+    m_inline_buffer[inline_capacity - 1] = static_cast<char>(inline_capacity - 1);
 }
 
 } // namespace CaveGame
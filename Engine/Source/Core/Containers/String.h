@@ -10,6 +10,9 @@
 
 #include <Core/Assertion.h>
 #include <Core/Containers/StringView.h>
+#include <Core/Memory/ReferenceCount.h>
+
+#include <new>
 
 namespace CaveGame
 {
@@ -17,10 +20,14 @@ namespace CaveGame
 //
 // Container that stores a UTF-8 encoded, null-terminated, copy-on-write (COW) string.
 //
-// If the string is small enough, the threshold being determined by the platform
-// architecture, no memory will be allocated from the heap and the characters will
-// be instead stored inline. This allows small strings to be very efficient in terms
-// of performance, as creating them would be very cheap.
+// If the string is small enough (at most `inline_capacity - 1` bytes, which is 23 bytes on 64-bit
+// platforms), no memory will be allocated from the heap and the characters will be instead stored
+// inline. This allows small strings to be very efficient in terms of performance, as creating them
+// would be very cheap. The string itself occupies three machine words.
+//
+// The last byte of the inline buffer stores the number of unused inline bytes, so when the inline
+// buffer is full it becomes zero and acts as the null terminator. Heap-allocated strings set the high
+// bit of that byte, which can never be set by an inline string.
 //
 class String
 {
@@ -37,7 +44,18 @@ public:
         CAVE_MAKE_NONCOPYABLE(HeapBuffer);
         CAVE_MAKE_NONMOVABLE(HeapBuffer);
 
-        u32 reference_count;
+        ALWAYS_INLINE HeapBuffer()
+            : reference_count(1)
+            , hash(0)
+        {}
+
+        // The heap buffer is shared by all copies of the string, which can live on different threads.
+        AtomicReferenceCount reference_count;
+        //
+        // The hash of the characters, computed the first time it is requested. Zero if it hasn't been computed yet.
+        // Multiple threads might compute the hash at the same time, but they always store the same value.
+        //
+        std::atomic<u64> hash;
         char characters[];
     };
 
@@ -45,8 +63,9 @@ public:
     #pragma warning(pop)
 #endif // CAVE_COMPILER_MSVC
 
-    static constexpr usize inline_capacity = sizeof(char*);
-    static_assert(inline_capacity > 0);
+    // The maximum number of bytes (including the null terminator) that can be stored inline.
+    static constexpr usize inline_capacity = 3 * sizeof(usize);
+    static_assert(inline_capacity < 0x80);
 
 public:
     String();
@@ -62,19 +81,52 @@ public:
     ~String();
 
 public:
-    NODISCARD ALWAYS_INLINE bool is_stored_inline() const { return (m_byte_count <= inline_capacity); }
+    NODISCARD ALWAYS_INLINE bool is_stored_inline() const { return (get_tag_byte() & heap_tag) == 0; }
 
-    NODISCARD ALWAYS_INLINE usize byte_count() const { return m_byte_count; }
-    NODISCARD ALWAYS_INLINE bool is_empty() const { return (m_byte_count == 1); }
+    // The number of bytes stored by the string, including the null terminator.
+    NODISCARD ALWAYS_INLINE usize byte_count() const { return is_stored_inline() ? (inline_capacity - get_tag_byte()) : m_heap.byte_count; }
+    NODISCARD ALWAYS_INLINE bool is_empty() const { return (byte_count() == 1); }
 
-    NODISCARD ALWAYS_INLINE const char* characters() const { return is_stored_inline() ? m_inline_buffer : m_heap_buffer->characters; }
+    NODISCARD ALWAYS_INLINE const char* characters() const { return is_stored_inline() ? m_inline_buffer : m_heap.buffer->characters; }
 
     NODISCARD ALWAYS_INLINE StringView view() const
     {
-        CAVE_ASSERT(m_byte_count >= 1);
-        return StringView::create_from_utf8(characters(), m_byte_count - 1);
+        if (is_stored_inline())
+            return StringView::create_from_utf8(m_inline_buffer, inline_capacity - 1 - get_tag_byte());
+        return StringView::create_from_utf8(m_heap.buffer->characters, m_heap.byte_count - 1);
     }
 
+    //
+    // Returns the hash of the string characters, which is equal to the hash of the string view.
+    // The hash of a heap-allocated string is cached in its buffer, so it is computed at most once for all copies of the string.
+    //
+    NODISCARD u64 hash() const;
+
+public:
+    //
+    // Returns whether or not the provided strings store the same sequence of bytes.
+    // Strings that share the same heap buffer are known to be equal without comparing their characters.
+    //
+    NODISCARD ALWAYS_INLINE bool operator==(const String& other) const
+    {
+        const usize count = byte_count();
+        if (count != other.byte_count())
+            return false;
+        if (!is_stored_inline() && m_heap.buffer == other.m_heap.buffer)
+            return true;
+        return memory_equals(characters(), other.characters(), count - 1);
+    }
+
+    NODISCARD ALWAYS_INLINE bool operator!=(const String& other) const
+    {
+        // NOTE: The inequal operator is derived from the equal operator by negating its result.
+        const bool are_equal = (*this == other);
+        return !are_equal;
+    }
+
+    NODISCARD ALWAYS_INLINE bool operator==(StringView other) const { return (view() == other); }
+    NODISCARD ALWAYS_INLINE bool operator!=(StringView other) const { return (view() != other); }
+
 public:
     void clear();
 
@@ -83,22 +135,60 @@ private:
     {
         const usize allocation_size = sizeof(HeapBuffer) + byte_count;
         void* memory_block = ::operator new(allocation_size);
-        return static_cast<HeapBuffer*>(memory_block);
+        return new (memory_block) HeapBuffer();
     }
 
     ALWAYS_INLINE void release_heap_buffer(HeapBuffer* heap_buffer, usize byte_count)
     {
-        MAYBE_UNUSED const usize allocation_size = sizeof(HeapBuffer) + byte_count;
-        ::operator delete(heap_buffer);
+        const usize allocation_size = sizeof(HeapBuffer) + byte_count;
+        heap_buffer->~HeapBuffer();
+        ::operator delete(heap_buffer, allocation_size);
     }
 
+    // The high bit of the tag byte is set only for heap-allocated strings.
+    static constexpr u8 heap_tag = 0x80;
+
+    NODISCARD ALWAYS_INLINE u8 get_tag_byte() const { return static_cast<u8>(m_inline_buffer[inline_capacity - 1]); }
+
+    // Stores the given characters inline and writes the null terminator. The byte count includes the null terminator.
+    void set_inline(const char* characters, usize byte_count);
+
+    // Takes a reference to the given heap buffer. The byte count includes the null terminator.
+    void set_heap(HeapBuffer* heap_buffer, usize byte_count);
+
+    // Sets the string to the empty string, without releasing the heap buffer (if any).
+    void set_empty();
+
 private:
-    usize m_byte_count;
+    struct HeapStorage
+    {
+        HeapBuffer* buffer;
+        usize byte_count;
+        u8 reserved[sizeof(usize) - 1];
+        // Overlaps the last byte of the inline buffer.
+        u8 tag;
+    };
+
     union
     {
         char m_inline_buffer[inline_capacity];
-        HeapBuffer* m_heap_buffer;
+        HeapStorage m_heap;
     };
 };
 
+static_assert(sizeof(String) == String::inline_capacity);
+
+// The string doesn't store pointers to itself, so it can be relocated by copying its bytes.
+template<>
+constexpr bool is_trivially_relocatable<String> = true;
+
+template<>
+struct Hasher<String>
+{
+    NODISCARD ALWAYS_INLINE static u64 hash(const String& string) { return string.hash(); }
+
+    // Allows string-keyed containers to be queried using string views, without creating a string.
+    NODISCARD ALWAYS_INLINE static u64 hash(StringView view) { return Hasher<StringView>::hash(view); }
+};
+
 } // namespace CaveGame
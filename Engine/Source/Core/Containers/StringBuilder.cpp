@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Assertion.h>
+#include <Core/Containers/StringBuilder.h>
+
+#include <charconv>
+
+namespace CaveGame
+{
+
+//
+// The formatting is implemented using `std::to_chars`, which never allocates memory, doesn't depend on the current
+// locale and produces the shortest representation that round-trips for floating point numbers.
+//
+
+usize Detail::format_signed_integer(char* destination, i64 value)
+{
+    const std::to_chars_result result = std::to_chars(destination, destination + max_formatted_number_byte_count, value);
+    CAVE_ASSERT(result.ec == std::errc());
+    return static_cast<usize>(result.ptr - destination);
+}
+
+usize Detail::format_unsigned_integer(char* destination, u64 value)
+{
+    const std::to_chars_result result = std::to_chars(destination, destination + max_formatted_number_byte_count, value);
+    CAVE_ASSERT(result.ec == std::errc());
+    return static_cast<usize>(result.ptr - destination);
+}
+
+usize Detail::format_float(char* destination, float value)
+{
+    const std::to_chars_result result = std::to_chars(destination, destination + max_formatted_number_byte_count, value);
+    CAVE_ASSERT(result.ec == std::errc());
+    return static_cast<usize>(result.ptr - destination);
+}
+
+usize Detail::format_float_fixed(char* destination, float value, u32 decimal_count)
+{
+    const std::to_chars_result result =
+        std::to_chars(destination, destination + max_formatted_number_byte_count, value, std::chars_format::fixed, static_cast<int>(decimal_count));
+    CAVE_ASSERT(result.ec == std::errc());
+    return static_cast<usize>(result.ptr - destination);
+}
+
+} // namespace CaveGame
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/InlineVector.h>
+#include <Core/Containers/String.h>
+#include <Core/Containers/StringView.h>
+#include <Core/Math/Vector.h>
+#include <Core/Memory/Allocators.h>
+
+namespace CaveGame
+{
+
+namespace Detail
+{
+
+//
+// The maximum number of bytes written by the number formatting functions below. The callers must ensure that the
+// destination buffer has at least this many bytes available.
+//
+static constexpr usize max_formatted_number_byte_count = 64;
+
+// The maximum number of decimals that can be requested when formatting a floating point number with fixed precision.
+static constexpr u32 max_formatted_decimal_count = 9;
+
+// Each function writes the textual representation of the value to the destination buffer and returns the number of bytes written.
+NODISCARD usize format_signed_integer(char* destination, i64 value);
+NODISCARD usize format_unsigned_integer(char* destination, u64 value);
+NODISCARD usize format_float(char* destination, float value);
+NODISCARD usize format_float_fixed(char* destination, float value, u32 decimal_count);
+
+} // namespace Detail
+
+//
+// Builds a string by appending views, characters and formatted values to a growable buffer.
+//
+// The first `inline_capacity` bytes are stored inside the builder itself, so building short strings (such as log lines
+// or paths) requires no allocation at all. Past that, the buffer grows geometrically using the `AllocatorType`.
+// Use the `FrameStringBuilder` alias to build temporary strings with memory allocated from the frame allocator.
+//
+template<typename AllocatorType = HeapAllocator>
+class BasicStringBuilder
+{
+public:
+    static constexpr usize inline_capacity = 128;
+
+public:
+    BasicStringBuilder() = default;
+
+    ALWAYS_INLINE explicit BasicStringBuilder(const AllocatorType& allocator)
+        : m_buffer(allocator)
+    {}
+
+public:
+    NODISCARD ALWAYS_INLINE usize byte_count() const { return m_buffer.count(); }
+    NODISCARD ALWAYS_INLINE bool is_empty() const { return m_buffer.is_empty(); }
+
+    // Returns a view towards the bytes appended so far. The view is invalidated by any subsequent append.
+    NODISCARD ALWAYS_INLINE StringView view() const { return StringView::create_from_utf8(m_buffer.elements(), m_buffer.count()); }
+
+    //
+    // Creates a string that stores the bytes appended so far. The characters are copied exactly once, either in the inline
+    // storage of the string (in which case no memory is allocated) or in a single heap buffer of the exact size.
+    //
+    NODISCARD ALWAYS_INLINE String to_string() const { return String(view()); }
+
+    // Ensures that at least `in_byte_count` bytes can be stored without expanding the buffer.
+    ALWAYS_INLINE void ensure_capacity(usize in_byte_count) { m_buffer.ensure_capacity(in_byte_count); }
+
+    // Removes all bytes from the builder, without releasing the buffer.
+    ALWAYS_INLINE void clear() { m_buffer.clear(); }
+
+public:
+    ALWAYS_INLINE void append(StringView view)
+    {
+        if (view.is_empty())
+            return;
+
+        const usize offset = m_buffer.count();
+        m_buffer.set_count_uninitialized(offset + view.byte_count());
+        copy_memory(m_buffer.elements() + offset, view.characters(), view.byte_count());
+    }
+
+    ALWAYS_INLINE void append(const String& string) { append(string.view()); }
+
+    ALWAYS_INLINE void append(char character) { m_buffer.add(character); }
+
+    //
+    // Appends the decimal representation of the integer.
+    // NOTE: The `char` and `bool` types are excluded, as appending them as integers is almost never intended.
+    //
+    template<typename T>
+    requires(std::is_integral_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, bool>)
+    ALWAYS_INLINE void append(T value)
+    {
+        char* destination = reserve_for_number();
+        if constexpr (std::is_signed_v<T>)
+            commit_number(Detail::format_signed_integer(destination, static_cast<i64>(value)));
+        else
+            commit_number(Detail::format_unsigned_integer(destination, static_cast<u64>(value)));
+    }
+
+    // Appends the shortest decimal representation that converts back to exactly the same value.
+    ALWAYS_INLINE void append(float value) { commit_number(Detail::format_float(reserve_for_number(), value)); }
+
+    // Appends the decimal representation of the value, with exactly `decimal_count` decimals.
+    ALWAYS_INLINE void append_fixed(float value, u32 decimal_count)
+    {
+        CAVE_ASSERT(decimal_count <= Detail::max_formatted_decimal_count);
+        commit_number(Detail::format_float_fixed(reserve_for_number(), value, decimal_count));
+    }
+
+    // Appends the vector in the "(x, y, z)" format.
+    ALWAYS_INLINE void append(Vector3 vector)
+    {
+        append('(');
+        append(vector.x);
+        append(", "sv);
+        append(vector.y);
+        append(", "sv);
+        append(vector.z);
+        append(')');
+    }
+
+private:
+    // Ensures that a number can be formatted directly at the end of the buffer, and returns the address where to write it.
+    NODISCARD ALWAYS_INLINE char* reserve_for_number()
+    {
+        m_buffer.ensure_capacity(m_buffer.count() + Detail::max_formatted_number_byte_count);
+        return m_buffer.elements() + m_buffer.count();
+    }
+
+    ALWAYS_INLINE void commit_number(usize written_byte_count)
+    {
+        CAVE_ASSERT(written_byte_count <= Detail::max_formatted_number_byte_count);
+        m_buffer.set_count_uninitialized(m_buffer.count() + written_byte_count);
+    }
+
+private:
+    InlineVector<char, inline_capacity, AllocatorType> m_buffer;
+};
+
+using StringBuilder = BasicStringBuilder<HeapAllocator>;
+using FrameStringBuilder = BasicStringBuilder<FrameAllocatorProxy>;
+
+} // namespace CaveGame
@@ -8,10 +8,595 @@
 
 #include <Core/Assertion.h>
 #include <Core/Containers/StringView.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Platform/CPUFeatures.h>
+
+#include <cstring>
+
+#if CAVE_ARCHITECTURE_X64
+    #include <immintrin.h>
+#endif // CAVE_ARCHITECTURE_X64
 
 namespace CaveGame
 {
 
+//======================================================================================
+// SCALAR PATHS.
+//======================================================================================
+
+ALWAYS_INLINE static bool is_utf8_continuation_byte(u8 byte) { return ((byte & 0xC0) == 0x80); }
+
+//
+// Validates the UTF-8 sequence that starts at the given offset and returns its length in bytes, or zero if the
+// sequence is invalid. The offset must be less than the byte count.
+//
+static usize validate_utf8_sequence(const u8* bytes, usize byte_count, usize offset)
+{
+    const u8 lead_byte = bytes[offset];
+    const usize remaining_byte_count = byte_count - offset;
+
+    if (lead_byte < 0x80)
+        return 1;
+
+    if ((lead_byte & 0xE0) == 0xC0)
+    {
+        // NOTE: The lead bytes 0xC0 and 0xC1 can only produce overlong encodings.
+        if (lead_byte < 0xC2 || remaining_byte_count < 2 || !is_utf8_continuation_byte(bytes[offset + 1]))
+            return 0;
+        return 2;
+    }
+
+    if ((lead_byte & 0xF0) == 0xE0)
+    {
+        if (remaining_byte_count < 3 || !is_utf8_continuation_byte(bytes[offset + 1]) || !is_utf8_continuation_byte(bytes[offset + 2]))
+            return 0;
+
+        const u32 codepoint = (static_cast<u32>(lead_byte & 0x0F) << 12) | (static_cast<u32>(bytes[offset + 1] & 0x3F) << 6);
+        // Reject the overlong encodings and the UTF-16 surrogates (U+D800 to U+DFFF).
+        if (codepoint < 0x800 || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+            return 0;
+        return 3;
+    }
+
+    if ((lead_byte & 0xF8) == 0xF0)
+    {
+        if (remaining_byte_count < 4 || !is_utf8_continuation_byte(bytes[offset + 1]) || !is_utf8_continuation_byte(bytes[offset + 2]) ||
+            !is_utf8_continuation_byte(bytes[offset + 3]))
+            return 0;
+
+        const u32 codepoint = (static_cast<u32>(lead_byte & 0x07) << 18) | (static_cast<u32>(bytes[offset + 1] & 0x3F) << 12);
+        // Reject the overlong encodings and the codepoints above U+10FFFF.
+        if (codepoint < 0x10000 || codepoint > 0x10FFFF)
+            return 0;
+        return 4;
+    }
+
+    // Continuation byte without a lead byte, or a lead byte of a sequence longer than 4 bytes.
+    return 0;
+}
+
+static usize find_any_of_scalar(const u8* bytes, usize byte_count, const u8* set, usize set_byte_count, usize offset)
+{
+    // Each bit of the table corresponds to a byte value, and is set if the byte is part of the set.
+    u64 table[4] = {};
+    for (usize set_index = 0; set_index < set_byte_count; ++set_index)
+        table[set[set_index] >> 6] |= u64(1) << (set[set_index] & 63);
+
+    for (; offset < byte_count; ++offset)
+    {
+        if (table[bytes[offset] >> 6] & (u64(1) << (bytes[offset] & 63)))
+            return offset;
+    }
+    return StringView::invalid_offset;
+}
+
+#if CAVE_ARCHITECTURE_X64
+
+//
+// Sets with at most this many bytes are searched by comparing each block against every byte of the set.
+// Larger sets are searched one byte at a time, using a lookup table.
+//
+static constexpr usize find_any_of_max_vectorized_set_byte_count = 8;
+
+//======================================================================================
+// SSE2 PATHS.
+//======================================================================================
+//
+// The byte comparisons produce a mask with one bit per byte, set if the byte matches. The lowest set bit of the mask
+// is the offset of the first match in the block. The blocks that would read past the end of the view are handled by
+// loading the last full block of the view, whose bytes before the current offset have already been searched.
+//
+
+// Returns whether or not the 16 bytes are all ASCII characters.
+ALWAYS_INLINE static bool is_ascii_16(const u8* bytes)
+{
+    return (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes))) == 0);
+}
+
+static bool is_valid_utf8_sse2(const u8* bytes, usize byte_count)
+{
+    // NOTE: SSE2 has no byte shuffle instruction, so only the ASCII blocks are vectorized. Text files are usually mostly
+    // ASCII, so the multi-byte sequences are validated one at a time, resuming the vectorized loop after them.
+    usize offset = 0;
+    while (offset < byte_count)
+    {
+        if (offset + 16 <= byte_count && is_ascii_16(bytes + offset))
+        {
+            offset += 16;
+            continue;
+        }
+
+        const usize sequence_byte_count = validate_utf8_sequence(bytes, byte_count, offset);
+        if (sequence_byte_count == 0)
+            return false;
+        offset += sequence_byte_count;
+    }
+    return true;
+}
+
+static usize count_codepoints_sse2(const u8* bytes, usize byte_count)
+{
+    // A byte starts a codepoint if it is not a continuation byte (0x80 to 0xBF, or -128 to -65 as signed values).
+    const __m128i continuation_byte_limit = _mm_set1_epi8(-65);
+    usize codepoint_count = 0;
+    usize offset = 0;
+
+    while (offset + 16 <= byte_count)
+    {
+        // The per-byte counters are 8-bit wide, so they are flushed at most every 255 blocks.
+        const usize block_count = Math::min<usize>((byte_count - offset) / 16, 255);
+        __m128i counters = _mm_setzero_si128();
+        for (usize block_index = 0; block_index < block_count; ++block_index)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + offset));
+            // The comparison produces -1 for each lead byte, so subtracting it increments the counter.
+            counters = _mm_sub_epi8(counters, _mm_cmpgt_epi8(block, continuation_byte_limit));
+            offset += 16;
+        }
+
+        const __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+        codepoint_count += static_cast<usize>(_mm_cvtsi128_si64(sums)) + static_cast<usize>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums)));
+    }
+
+    for (; offset < byte_count; ++offset)
+        codepoint_count += !is_utf8_continuation_byte(bytes[offset]);
+    return codepoint_count;
+}
+
+static usize find_any_of_sse2(const u8* bytes, usize byte_count, const u8* set, usize set_byte_count, usize offset)
+{
+    if (byte_count - offset < 16 || set_byte_count > find_any_of_max_vectorized_set_byte_count)
+        return find_any_of_scalar(bytes, byte_count, set, set_byte_count, offset);
+
+    __m128i set_vectors[find_any_of_max_vectorized_set_byte_count];
+    for (usize set_index = 0; set_index < set_byte_count; ++set_index)
+        set_vectors[set_index] = _mm_set1_epi8(static_cast<char>(set[set_index]));
+
+    while (true)
+    {
+        const usize block_offset = Math::min(offset, byte_count - 16);
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + block_offset));
+        __m128i matches = _mm_setzero_si128();
+        for (usize set_index = 0; set_index < set_byte_count; ++set_index)
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, set_vectors[set_index]));
+
+        const u32 match_mask = static_cast<u32>(_mm_movemask_epi8(matches));
+        if (match_mask != 0)
+            return block_offset + Math::count_trailing_zeros(match_mask);
+
+        offset = block_offset + 16;
+        if (offset >= byte_count)
+            return StringView::invalid_offset;
+    }
+}
+
+//
+// Finds a substring of at least two bytes. Each block of candidate positions is filtered by comparing both the first
+// and the last byte of the substring, and only the positions where both match are compared entirely.
+// The candidate positions are in the [offset, last_offset] range.
+//
+static usize find_substring_sse2(const u8* bytes, const u8* substring, usize substring_byte_count, usize offset, usize last_offset)
+{
+    const __m128i first_byte = _mm_set1_epi8(static_cast<char>(substring[0]));
+    const __m128i last_byte = _mm_set1_epi8(static_cast<char>(substring[substring_byte_count - 1]));
+
+    while (offset + 16 <= last_offset + 1)
+    {
+        const __m128i first_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + offset));
+        const __m128i last_block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + offset + substring_byte_count - 1));
+        u32 candidate_mask = static_cast<u32>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first_block, first_byte), _mm_cmpeq_epi8(last_block, last_byte))));
+
+        while (candidate_mask != 0)
+        {
+            const usize candidate_offset = offset + Math::count_trailing_zeros(candidate_mask);
+            if (memory_equals(bytes + candidate_offset + 1, substring + 1, substring_byte_count - 2))
+                return candidate_offset;
+            // Clear the lowest set bit.
+            candidate_mask &= candidate_mask - 1;
+        }
+
+        offset += 16;
+    }
+
+    for (; offset <= last_offset; ++offset)
+    {
+        if (bytes[offset] == substring[0] && memory_equals(bytes + offset + 1, substring + 1, substring_byte_count - 1))
+            return offset;
+    }
+    return StringView::invalid_offset;
+}
+
+//======================================================================================
+// AVX2 PATHS.
+//======================================================================================
+
+//
+// The UTF-8 validation uses the lookup algorithm described by John Keiser and Daniel Lemire in "Validating UTF-8 In Less
+// Than One Instruction Per Byte" (also used by the simdjson and simdutf libraries).
+//
+// Every pair of consecutive bytes is classified using three 16-entry lookup tables, indexed by the high nibble of the
+// previous byte, the low nibble of the previous byte and the high nibble of the current byte. Each table entry is a set
+// of error bits, and the pair is invalid if the three entries have an error bit in common. The errors that span more
+// than two bytes (missing or excess continuation bytes of the 3-byte and 4-byte sequences) are detected separately.
+//
+
+// Lead byte (or ASCII character) followed by a lead byte or ASCII character, when a continuation byte is expected.
+static constexpr u8 utf8_error_too_short = 1 << 0;
+// ASCII character followed by a continuation byte.
+static constexpr u8 utf8_error_too_long = 1 << 1;
+static constexpr u8 utf8_error_overlong_3 = 1 << 2;
+static constexpr u8 utf8_error_too_large = 1 << 3;
+static constexpr u8 utf8_error_surrogate = 1 << 4;
+static constexpr u8 utf8_error_overlong_2 = 1 << 5;
+// NOTE: The overlong 4-byte encodings and the too large codepoints whose second byte is 1000____ share the same bit.
+static constexpr u8 utf8_error_too_large_1000 = 1 << 6;
+static constexpr u8 utf8_error_overlong_4 = 1 << 6;
+static constexpr u8 utf8_error_two_continuations = 1 << 7;
+// The errors that are determined only by the high nibble of the previous byte.
+static constexpr u8 utf8_error_carry = utf8_error_too_short | utf8_error_too_long | utf8_error_two_continuations;
+
+#define CAVE_UTF8_LOOKUP_TABLE(...) _mm256_setr_epi8(__VA_ARGS__, __VA_ARGS__)
+
+// Returns the 32 bytes that precede each byte of the current block by `N` positions, spanning the previous block.
+template<i32 N>
+CAVE_TARGET_AVX2 ALWAYS_INLINE static __m256i get_previous_bytes(__m256i block, __m256i previous_block)
+{
+    return _mm256_alignr_epi8(block, _mm256_permute2x128_si256(previous_block, block, 0x21), 16 - N);
+}
+
+CAVE_TARGET_AVX2 ALWAYS_INLINE static __m256i get_high_nibbles(__m256i block)
+{
+    return _mm256_and_si256(_mm256_srli_epi16(block, 4), _mm256_set1_epi8(0x0F));
+}
+
+CAVE_TARGET_AVX2 static __m256i get_utf8_two_byte_errors(__m256i block, __m256i previous_bytes)
+{
+    constexpr char too_short = static_cast<char>(utf8_error_too_short);
+    constexpr char too_long = static_cast<char>(utf8_error_too_long);
+    constexpr char two_continuations = static_cast<char>(utf8_error_two_continuations);
+    constexpr char carry = static_cast<char>(utf8_error_carry);
+
+    const __m256i previous_high_nibble_table = CAVE_UTF8_LOOKUP_TABLE(
+        // 0_______ : ASCII character.
+        too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+        // 10______ : Continuation byte.
+        two_continuations, two_continuations, two_continuations, two_continuations,
+        // 1100____ : Lead byte of a 2-byte sequence.
+        static_cast<char>(utf8_error_too_short | utf8_error_overlong_2),
+        // 1101____ : Lead byte of a 2-byte sequence.
+        too_short,
+        // 1110____ : Lead byte of a 3-byte sequence.
+        static_cast<char>(utf8_error_too_short | utf8_error_overlong_3 | utf8_error_surrogate),
+        // 1111____ : Lead byte of a 4-byte sequence.
+        static_cast<char>(utf8_error_too_short | utf8_error_too_large | utf8_error_too_large_1000 | utf8_error_overlong_4));
+
+    constexpr char carry_too_large = static_cast<char>(utf8_error_carry | utf8_error_too_large | utf8_error_too_large_1000);
+    const __m256i previous_low_nibble_table = CAVE_UTF8_LOOKUP_TABLE(
+        // ____0000
+        static_cast<char>(utf8_error_carry | utf8_error_overlong_3 | utf8_error_overlong_2 | utf8_error_overlong_4),
+        // ____0001
+        static_cast<char>(utf8_error_carry | utf8_error_overlong_2),
+        // ____001_
+        carry, carry,
+        // ____0100
+        static_cast<char>(utf8_error_carry | utf8_error_too_large),
+        // ____0101 and ____011_
+        carry_too_large, carry_too_large, carry_too_large,
+        // ____1___
+        carry_too_large, carry_too_large, carry_too_large, carry_too_large, carry_too_large,
+        // ____1101
+        static_cast<char>(utf8_error_carry | utf8_error_too_large | utf8_error_too_large_1000 | utf8_error_surrogate),
+        carry_too_large, carry_too_large);
+
+    const __m256i current_high_nibble_table = CAVE_UTF8_LOOKUP_TABLE(
+        // 0_______ : ASCII character.
+        too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+        // 1000____
+        static_cast<char>(utf8_error_too_long | utf8_error_overlong_2 | utf8_error_two_continuations | utf8_error_overlong_3 | utf8_error_too_large_1000 |
+                          utf8_error_overlong_4),
+        // 1001____
+        static_cast<char>(utf8_error_too_long | utf8_error_overlong_2 | utf8_error_two_continuations | utf8_error_overlong_3 | utf8_error_too_large),
+        // 101_____
+        static_cast<char>(utf8_error_too_long | utf8_error_overlong_2 | utf8_error_two_continuations | utf8_error_surrogate | utf8_error_too_large),
+        static_cast<char>(utf8_error_too_long | utf8_error_overlong_2 | utf8_error_two_continuations | utf8_error_surrogate | utf8_error_too_large),
+        // 11______ : Lead byte.
+        too_short, too_short, too_short, too_short);
+
+    const __m256i previous_high_errors = _mm256_shuffle_epi8(previous_high_nibble_table, get_high_nibbles(previous_bytes));
+    const __m256i previous_low_errors = _mm256_shuffle_epi8(previous_low_nibble_table, _mm256_and_si256(previous_bytes, _mm256_set1_epi8(0x0F)));
+    const __m256i current_high_errors = _mm256_shuffle_epi8(current_high_nibble_table, get_high_nibbles(block));
+    return _mm256_and_si256(_mm256_and_si256(previous_high_errors, previous_low_errors), current_high_errors);
+}
+
+#undef CAVE_UTF8_LOOKUP_TABLE
+
+CAVE_TARGET_AVX2 static __m256i get_utf8_block_errors(__m256i block, __m256i previous_block)
+{
+    const __m256i two_byte_errors = get_utf8_two_byte_errors(block, get_previous_bytes<1>(block, previous_block));
+
+    //
+    // A byte must be the third or fourth byte of a sequence if the byte two positions before is a 3-byte or 4-byte lead
+    // byte (111_____), or the byte three positions before is a 4-byte lead byte (1111____). The subtractions set the
+    // highest bit only for these lead bytes. Such bytes are marked by the two-byte classification as having two
+    // continuations, so the bit must be set exactly when it is expected, otherwise the sequence is too short or too long.
+    //
+    const __m256i third_byte_marks = _mm256_subs_epu8(get_previous_bytes<2>(block, previous_block), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    const __m256i fourth_byte_marks = _mm256_subs_epu8(get_previous_bytes<3>(block, previous_block), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    const __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(third_byte_marks, fourth_byte_marks), _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(must_be_continuation, two_byte_errors);
+}
+
+// Returns a non-zero vector if the block ends with a multi-byte sequence that continues in the next block.
+CAVE_TARGET_AVX2 ALWAYS_INLINE static __m256i get_utf8_incomplete_mask(__m256i block)
+{
+    // NOTE: Only the last three bytes can start a sequence that doesn't fit in the block.
+    const __m256i max_complete_bytes = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+    return _mm256_subs_epu8(block, max_complete_bytes);
+}
+
+CAVE_TARGET_AVX2 static bool is_valid_utf8_avx2(const u8* bytes, usize byte_count)
+{
+    __m256i errors = _mm256_setzero_si256();
+    __m256i previous_block = _mm256_setzero_si256();
+    __m256i previous_incomplete_mask = _mm256_setzero_si256();
+
+    usize offset = 0;
+    while (true)
+    {
+        __m256i block;
+        const bool is_last_block = (offset + 32 > byte_count);
+        if (!is_last_block)
+        {
+            block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + offset));
+        }
+        else
+        {
+            // The last (partial) block is padded with zeros. The zeros are ASCII characters, so any sequence that is
+            // truncated by the end of the view will be reported as too short.
+            alignas(32) u8 padded_block[32] = {};
+            copy_memory(padded_block, bytes + offset, byte_count - offset);
+            block = _mm256_load_si256(reinterpret_cast<const __m256i*>(padded_block));
+        }
+
+        if (_mm256_movemask_epi8(block) == 0)
+        {
+            // The block only contains ASCII characters, so it is only invalid if the previous block ended with an incomplete sequence.
+            errors = _mm256_or_si256(errors, previous_incomplete_mask);
+            previous_incomplete_mask = _mm256_setzero_si256();
+        }
+        else
+        {
+            errors = _mm256_or_si256(errors, get_utf8_block_errors(block, previous_block));
+            previous_incomplete_mask = get_utf8_incomplete_mask(block);
+        }
+
+        previous_block = block;
+        if (is_last_block)
+            break;
+        offset += 32;
+
+        // Exit early from large invalid inputs. The check is amortized over multiple blocks.
+        if ((offset & 1023) == 0 && !_mm256_testz_si256(errors, errors))
+            return false;
+    }
+
+    return _mm256_testz_si256(errors, errors);
+}
+
+CAVE_TARGET_AVX2 static usize count_codepoints_avx2(const u8* bytes, usize byte_count)
+{
+    const __m256i continuation_byte_limit = _mm256_set1_epi8(-65);
+    usize codepoint_count = 0;
+    usize offset = 0;
+
+    while (offset + 32 <= byte_count)
+    {
+        const usize block_count = Math::min<usize>((byte_count - offset) / 32, 255);
+        __m256i counters = _mm256_setzero_si256();
+        for (usize block_index = 0; block_index < block_count; ++block_index)
+        {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + offset));
+            counters = _mm256_sub_epi8(counters, _mm256_cmpgt_epi8(block, continuation_byte_limit));
+            offset += 32;
+        }
+
+        const __m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+        codepoint_count += static_cast<usize>(_mm256_extract_epi64(sums, 0)) + static_cast<usize>(_mm256_extract_epi64(sums, 1)) +
+                           static_cast<usize>(_mm256_extract_epi64(sums, 2)) + static_cast<usize>(_mm256_extract_epi64(sums, 3));
+    }
+
+    return codepoint_count + count_codepoints_sse2(bytes + offset, byte_count - offset);
+}
+
+CAVE_TARGET_AVX2 static usize find_any_of_avx2(const u8* bytes, usize byte_count, const u8* set, usize set_byte_count, usize offset)
+{
+    if (byte_count - offset < 32 || set_byte_count > find_any_of_max_vectorized_set_byte_count)
+        return find_any_of_sse2(bytes, byte_count, set, set_byte_count, offset);
+
+    __m256i set_vectors[find_any_of_max_vectorized_set_byte_count];
+    for (usize set_index = 0; set_index < set_byte_count; ++set_index)
+        set_vectors[set_index] = _mm256_set1_epi8(static_cast<char>(set[set_index]));
+
+    while (true)
+    {
+        const usize block_offset = Math::min(offset, byte_count - 32);
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + block_offset));
+        __m256i matches = _mm256_setzero_si256();
+        for (usize set_index = 0; set_index < set_byte_count; ++set_index)
+            matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, set_vectors[set_index]));
+
+        const u32 match_mask = static_cast<u32>(_mm256_movemask_epi8(matches));
+        if (match_mask != 0)
+            return block_offset + Math::count_trailing_zeros(match_mask);
+
+        offset = block_offset + 32;
+        if (offset >= byte_count)
+            return StringView::invalid_offset;
+    }
+}
+
+CAVE_TARGET_AVX2 static usize find_substring_avx2(const u8* bytes, const u8* substring, usize substring_byte_count, usize offset, usize last_offset)
+{
+    const __m256i first_byte = _mm256_set1_epi8(static_cast<char>(substring[0]));
+    const __m256i last_byte = _mm256_set1_epi8(static_cast<char>(substring[substring_byte_count - 1]));
+
+    while (offset + 32 <= last_offset + 1)
+    {
+        const __m256i first_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + offset));
+        const __m256i last_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + offset + substring_byte_count - 1));
+        u32 candidate_mask =
+            static_cast<u32>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first_block, first_byte), _mm256_cmpeq_epi8(last_block, last_byte))));
+
+        while (candidate_mask != 0)
+        {
+            const usize candidate_offset = offset + Math::count_trailing_zeros(candidate_mask);
+            if (memory_equals(bytes + candidate_offset + 1, substring + 1, substring_byte_count - 2))
+                return candidate_offset;
+            candidate_mask &= candidate_mask - 1;
+        }
+
+        offset += 32;
+    }
+
+    return find_substring_sse2(bytes, substring, substring_byte_count, offset, last_offset);
+}
+
+//======================================================================================
+// RUNTIME DISPATCH.
+//======================================================================================
+
+using IsValidUTF8Function = bool (*)(const u8*, usize);
+using CountCodepointsFunction = usize (*)(const u8*, usize);
+using FindAnyOfFunction = usize (*)(const u8*, usize, const u8*, usize, usize);
+using FindSubstringFunction = usize (*)(const u8*, const u8*, usize, usize, usize);
+
+struct StringViewKernels
+{
+    IsValidUTF8Function is_valid_utf8;
+    CountCodepointsFunction count_codepoints;
+    FindAnyOfFunction find_any_of;
+    FindSubstringFunction find_substring;
+};
+
+static StringViewKernels select_string_view_kernels()
+{
+    StringViewKernels kernels;
+    if (get_cpu_features().has_avx2)
+    {
+        kernels.is_valid_utf8 = is_valid_utf8_avx2;
+        kernels.count_codepoints = count_codepoints_avx2;
+        kernels.find_any_of = find_any_of_avx2;
+        kernels.find_substring = find_substring_avx2;
+    }
+    else
+    {
+        kernels.is_valid_utf8 = is_valid_utf8_sse2;
+        kernels.count_codepoints = count_codepoints_sse2;
+        kernels.find_any_of = find_any_of_sse2;
+        kernels.find_substring = find_substring_sse2;
+    }
+    return kernels;
+}
+
+//
+// Returns the kernels best suited for the CPU the program is running on.
+// The selection is performed only once, the first time this function is called.
+//
+ALWAYS_INLINE static const StringViewKernels& get_string_view_kernels()
+{
+    static const StringViewKernels s_kernels = select_string_view_kernels();
+    return s_kernels;
+}
+
+#else
+
+//======================================================================================
+// PORTABLE PATHS.
+//======================================================================================
+//
+// NOTE: There are no vectorized kernels for this architecture, so the scalar paths are used directly.
+//
+
+static bool is_valid_utf8_scalar(const u8* bytes, usize byte_count)
+{
+    usize offset = 0;
+    while (offset < byte_count)
+    {
+        const usize sequence_byte_count = validate_utf8_sequence(bytes, byte_count, offset);
+        if (sequence_byte_count == 0)
+            return false;
+        offset += sequence_byte_count;
+    }
+    return true;
+}
+
+static usize count_codepoints_scalar(const u8* bytes, usize byte_count)
+{
+    usize codepoint_count = 0;
+    for (usize offset = 0; offset < byte_count; ++offset)
+        codepoint_count += !is_utf8_continuation_byte(bytes[offset]);
+    return codepoint_count;
+}
+
+static usize find_substring_scalar(const u8* bytes, const u8* substring, usize substring_byte_count, usize offset, usize last_offset)
+{
+    for (; offset <= last_offset; ++offset)
+    {
+        if (bytes[offset] == substring[0] && memory_equals(bytes + offset + 1, substring + 1, substring_byte_count - 1))
+            return offset;
+    }
+    return StringView::invalid_offset;
+}
+
+struct StringViewKernels
+{
+    ALWAYS_INLINE static bool is_valid_utf8(const u8* bytes, usize byte_count) { return is_valid_utf8_scalar(bytes, byte_count); }
+    ALWAYS_INLINE static usize count_codepoints(const u8* bytes, usize byte_count) { return count_codepoints_scalar(bytes, byte_count); }
+
+    ALWAYS_INLINE static usize find_any_of(const u8* bytes, usize byte_count, const u8* set, usize set_byte_count, usize offset)
+    {
+        return find_any_of_scalar(bytes, byte_count, set, set_byte_count, offset);
+    }
+
+    ALWAYS_INLINE static usize find_substring(const u8* bytes, const u8* substring, usize substring_byte_count, usize offset, usize last_offset)
+    {
+        return find_substring_scalar(bytes, substring, substring_byte_count, offset, last_offset);
+    }
+};
+
+ALWAYS_INLINE static StringViewKernels get_string_view_kernels()
+{
+    return {};
+}
+
+#endif // CAVE_ARCHITECTURE_X64
+
+//======================================================================================
+// STRING VIEW.
+//======================================================================================
+
 StringView StringView::create_from_utf8(const char* characters, usize byte_count)
 {
     StringView view;
@@ -33,4 +618,58 @@ StringView StringView::create_from_utf8(const char* null_terminated_characters)
     return view;
 }
 
+bool StringView::try_create_from_utf8(const char* characters, usize byte_count, StringView& out_view)
+{
+    if (!is_valid_utf8(characters, byte_count))
+        return false;
+
+    out_view = create_from_utf8(characters, byte_count);
+    return true;
+}
+
+bool StringView::is_valid_utf8(const char* characters, usize byte_count)
+{
+    return get_string_view_kernels().is_valid_utf8(reinterpret_cast<const u8*>(characters), byte_count);
+}
+
+usize StringView::codepoint_count() const
+{
+    return get_string_view_kernels().count_codepoints(reinterpret_cast<const u8*>(m_characters), m_byte_count);
+}
+
+usize StringView::find(char character, usize start_offset) const
+{
+    if (start_offset >= m_byte_count)
+        return invalid_offset;
+
+    // NOTE: The C library implementation of `memchr` is already vectorized and aligns its loads, which makes it faster
+    // than a custom kernel for searching a single byte.
+    const void* match = std::memchr(m_characters + start_offset, character, m_byte_count - start_offset);
+    if (match == nullptr)
+        return invalid_offset;
+    return static_cast<usize>(static_cast<const char*>(match) - m_characters);
+}
+
+usize StringView::find(StringView substring, usize start_offset) const
+{
+    if (start_offset > m_byte_count || substring.m_byte_count > m_byte_count - start_offset)
+        return invalid_offset;
+    if (substring.m_byte_count == 0)
+        return start_offset;
+    if (substring.m_byte_count == 1)
+        return find(substring.m_characters[0], start_offset);
+
+    const usize last_offset = m_byte_count - substring.m_byte_count;
+    return get_string_view_kernels().find_substring(reinterpret_cast<const u8*>(m_characters), reinterpret_cast<const u8*>(substring.m_characters),
+                                                    substring.m_byte_count, start_offset, last_offset);
+}
+
+usize StringView::find_any_of(StringView character_set, usize start_offset) const
+{
+    if (start_offset >= m_byte_count || character_set.is_empty())
+        return invalid_offset;
+    return get_string_view_kernels().find_any_of(reinterpret_cast<const u8*>(m_characters), m_byte_count,
+                                                 reinterpret_cast<const u8*>(character_set.m_characters), character_set.m_byte_count, start_offset);
+}
+
 } // namespace CaveGame
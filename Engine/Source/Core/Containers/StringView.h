@@ -8,7 +8,11 @@
 
 #pragma once
 
+#include <Core/Assertion.h>
+#include <Core/Containers/Vector.h>
 #include <Core/CoreTypes.h>
+#include <Core/Hash/Hash.h>
+#include <Core/Memory/MemoryOperations.h>
 
 namespace CaveGame
 {
@@ -29,9 +33,27 @@ class StringView
     friend class StringView constexpr operator""sv(const char*, usize);
 
 public:
+    // The value returned by the search functions when no match is found.
+    static constexpr usize invalid_offset = static_cast<usize>(-1);
+
+public:
+    //
+    // Creates a view towards the given bytes, which are assumed to be valid UTF-8. No validation is performed, so these
+    // functions should only be used for trusted input (such as string literals or strings created by the engine).
+    // Use `try_create_from_utf8` for input read from files or received from the network.
+    //
     NODISCARD static StringView create_from_utf8(const char* characters, usize byte_count);
     NODISCARD static StringView create_from_utf8(const char* null_terminated_characters);
 
+    //
+    // Creates a view towards the given bytes, only if they form a valid UTF-8 sequence (overlong encodings, surrogates
+    // and codepoints above U+10FFFF are rejected). Returns false and leaves the output view unmodified otherwise.
+    //
+    NODISCARD static bool try_create_from_utf8(const char* characters, usize byte_count, StringView& out_view);
+
+    // Returns whether or not the given bytes form a valid UTF-8 sequence.
+    NODISCARD static bool is_valid_utf8(const char* characters, usize byte_count);
+
 public:
     ALWAYS_INLINE constexpr StringView()
         : m_characters(nullptr)
@@ -77,6 +99,99 @@ public:
 
     NODISCARD ALWAYS_INLINE bool is_empty() const { return (m_byte_count == 0); }
 
+    // Returns the number of Unicode codepoints encoded by the view. The view must contain valid UTF-8.
+    NODISCARD usize codepoint_count() const;
+
+    //
+    // Returns a view towards `count` bytes starting at the given byte offset. Both offsets must lie on codepoint
+    // boundaries, otherwise the returned view will not contain valid UTF-8.
+    //
+    NODISCARD ALWAYS_INLINE StringView substring(usize offset, usize count) const
+    {
+        CAVE_ASSERT(offset + count <= m_byte_count);
+        return create_from_utf8(m_characters + offset, count);
+    }
+
+    // Returns a view towards all bytes starting at the given byte offset.
+    NODISCARD ALWAYS_INLINE StringView substring(usize offset) const
+    {
+        CAVE_ASSERT(offset <= m_byte_count);
+        return create_from_utf8(m_characters + offset, m_byte_count - offset);
+    }
+
+public:
+    //
+    // The search functions return the byte offset of the first match located at or after `start_offset`, or
+    // `invalid_offset` if there is no match. The substrings and character sets are compared using SSE2 or AVX2 (when
+    // supported by the CPU), while single characters are searched using `memchr`.
+    //
+    // Searching for ASCII characters is always safe, as ASCII bytes never appear inside multi-byte UTF-8 sequences.
+    //
+
+    NODISCARD usize find(char character, usize start_offset = 0) const;
+    NODISCARD usize find(StringView substring, usize start_offset = 0) const;
+
+    // Finds the first occurrence of any of the bytes stored in the given set.
+    NODISCARD usize find_any_of(StringView character_set, usize start_offset = 0) const;
+
+    NODISCARD ALWAYS_INLINE bool contains(char character) const { return (find(character) != invalid_offset); }
+    NODISCARD ALWAYS_INLINE bool contains(StringView substring) const { return (find(substring) != invalid_offset); }
+
+    NODISCARD ALWAYS_INLINE bool starts_with(StringView prefix) const
+    {
+        if (prefix.m_byte_count > m_byte_count)
+            return false;
+        return memory_equals(m_characters, prefix.m_characters, prefix.m_byte_count);
+    }
+
+    NODISCARD ALWAYS_INLINE bool ends_with(StringView suffix) const
+    {
+        if (suffix.m_byte_count > m_byte_count)
+            return false;
+        return memory_equals(m_characters + (m_byte_count - suffix.m_byte_count), suffix.m_characters, suffix.m_byte_count);
+    }
+
+    //
+    // Splits the view at every occurrence of the delimiter and adds the parts to the provided vector.
+    // Empty parts (between two consecutive delimiters or at the ends) are kept, so splitting a view that contains
+    // N delimiters always produces N + 1 parts. The parts reference the bytes of this view, so no string is copied.
+    //
+    template<typename AllocatorType>
+    void split(char delimiter, Vector<StringView, AllocatorType>& out_parts) const
+    {
+        usize part_offset = 0;
+        while (true)
+        {
+            const usize delimiter_offset = find(delimiter, part_offset);
+            if (delimiter_offset == invalid_offset)
+                break;
+
+            out_parts.add(substring(part_offset, delimiter_offset - part_offset));
+            part_offset = delimiter_offset + 1;
+        }
+
+        out_parts.add(substring(part_offset));
+    }
+
+public:
+    //
+    // Returns whether or not the provided views reference the same sequence of bytes.
+    // The characters are compared byte by byte, so no Unicode normalization is performed.
+    //
+    NODISCARD ALWAYS_INLINE bool operator==(const StringView& other) const
+    {
+        if (m_byte_count != other.m_byte_count)
+            return false;
+        return memory_equals(m_characters, other.m_characters, m_byte_count);
+    }
+
+    NODISCARD ALWAYS_INLINE bool operator!=(const StringView& other) const
+    {
+        // NOTE: The inequal operator is derived from the equal operator by negating its result.
+        const bool are_equal = (*this == other);
+        return !are_equal;
+    }
+
 private:
     const char* m_characters;
     usize m_byte_count;
@@ -95,4 +210,10 @@ NODISCARD ALWAYS_INLINE constexpr StringView operator""sv(const char* ascii_lite
     #pragma warning(pop)
 #endif // CAVE_COMPILER_MSVC
 
+template<>
+struct Hasher<StringView>
+{
+    NODISCARD ALWAYS_INLINE static u64 hash(StringView view) { return Hash::string(view.characters(), view.byte_count()); }
+};
+
 } // namespace CaveGame
@@ -9,7 +9,9 @@
 #pragma once
 
 #include <Core/Assertion.h>
+#include <Core/Containers/VectorCommon.h>
 #include <Core/CoreTypes.h>
+#include <Core/Memory/Allocators.h>
 
 namespace CaveGame
 {
@@ -18,16 +20,14 @@ namespace CaveGame
 // Container that stores and manages a contiguos array of heap-allocated elements.
 // This is our equivalent implementation of the `std::vector` container.
 //
-template<typename T>
+// The memory block is provided by the `AllocatorType` (see `Core/Memory/Allocators.h`), which by default is the global heap.
+// When the allocator is able to grow the memory block in place (for example, when the block is the last allocation
+// made from a linear allocator), the vector expands without moving its elements.
+//
+template<typename T, typename AllocatorType = HeapAllocator>
 class Vector
 {
 public:
-    static constexpr usize growth_factor_numerator = 3;
-    static constexpr usize growth_factor_denominator = 2;
-    // NOTE: The growth factor must always be strictly greater than one, otherwise the vector
-    // will always expand by only one element, no matter its size. This can create performance issues.
-    static_assert(growth_factor_numerator > growth_factor_denominator);
-
     using Iterator = T*;
     using ConstIterator = const T*;
     // using ReverseIterator = T*;
@@ -40,18 +40,27 @@ public:
         , m_count(0)
     {}
 
+    ALWAYS_INLINE explicit Vector(const AllocatorType& allocator)
+        : m_elements(nullptr)
+        , m_capacity(0)
+        , m_count(0)
+        , m_allocator(allocator)
+    {}
+
     ALWAYS_INLINE Vector(const Vector& other)
         : m_capacity(other.m_count)
         , m_count(other.m_count)
+        , m_allocator(other.m_allocator)
     {
         m_elements = allocate_memory(m_capacity);
-        copy_elements(m_elements, other.m_elements, m_count);
+        Detail::copy_vector_elements(m_elements, other.m_elements, m_count);
     }
 
     ALWAYS_INLINE Vector(Vector&& other) noexcept
         : m_elements(other.m_elements)
         , m_capacity(other.m_capacity)
         , m_count(other.m_count)
+        , m_allocator(other.m_allocator)
     {
         other.m_elements = nullptr;
         other.m_capacity = 0;
@@ -73,7 +82,8 @@ public:
             m_elements = allocate_memory(m_capacity);
         }
 
-        copy_elements(m_elements, other.m_elements, m_count);
+        Detail::copy_vector_elements(m_elements, other.m_elements, other.m_count);
+        m_count = other.m_count;
         return *this;
     }
 
@@ -85,6 +95,8 @@ public:
 
         clear_and_shrink();
 
+        // The memory block is now owned by this vector, so it must be released using the allocator it was allocated with.
+        m_allocator = other.m_allocator;
         m_elements = other.m_elements;
         m_capacity = other.m_capacity;
         m_count = other.m_count;
@@ -112,6 +124,9 @@ public:
     NODISCARD ALWAYS_INLINE bool is_empty() const { return (m_count == 0); }
     NODISCARD ALWAYS_INLINE bool has_elements() const { return (m_count > 0); }
 
+    NODISCARD ALWAYS_INLINE AllocatorType& allocator() { return m_allocator; }
+    NODISCARD ALWAYS_INLINE const AllocatorType& allocator() const { return m_allocator; }
+
 public:
     //
     // Returns the element stored at the given index in the internal array.
@@ -206,8 +221,7 @@ public:
     //
     ALWAYS_INLINE void clear()
     {
-        for (usize index = 0; index < m_count; ++index)
-            m_elements[index].~T();
+        Detail::destroy_vector_elements(m_elements, m_count);
         m_count = 0;
     }
 
@@ -235,7 +249,7 @@ public:
             return;
 
         T* new_elements = allocate_memory(m_count);
-        move_elements(new_elements, m_elements, m_count);
+        Detail::move_vector_elements(new_elements, m_elements, m_count);
 
         release_memory(m_elements, m_capacity);
         m_elements = new_elements;
@@ -250,9 +264,12 @@ public:
         if (m_capacity >= in_capacity)
             return;
 
-        const usize new_capacity = calculate_next_capacity(in_capacity, m_capacity);
+        const usize new_capacity = Detail::calculate_next_vector_capacity(in_capacity, m_capacity);
+        if (try_expand_memory_in_place(new_capacity))
+            return;
+
         T* new_elements = allocate_memory(new_capacity);
-        move_elements(new_elements, m_elements, m_count);
+        Detail::move_vector_elements(new_elements, m_elements, m_count);
 
         release_memory(m_elements, m_capacity);
         m_elements = new_elements;
@@ -266,9 +283,12 @@ public:
         if (m_capacity == in_capacity)
             return;
 
-        CAVE_ASSERT(in_capacity > m_count);
+        CAVE_ASSERT(in_capacity >= m_count);
+        if (in_capacity > m_capacity && try_expand_memory_in_place(in_capacity))
+            return;
+
         T* new_elements = allocate_memory(in_capacity);
-        move_elements(new_elements, m_elements, m_count);
+        Detail::move_vector_elements(new_elements, m_elements, m_count);
 
         release_memory(m_elements, m_capacity);
         m_elements = new_elements;
@@ -284,10 +304,9 @@ public:
 
         ensure_capacity(in_count);
 
-        // If the new count is less than the current count the last `m_count - in_count` elements
-        // must be destroyed. Note that if this is not the case, this loop does nothing.
-        for (usize index = in_count; index < m_count; ++index)
-            m_elements[index].~T();
+        // If the new count is less than the current count the last `m_count - in_count` elements must be destroyed.
+        if (in_count < m_count)
+            Detail::destroy_vector_elements(m_elements + in_count, m_count - in_count);
 
         m_count = in_count;
     }
@@ -297,7 +316,7 @@ public:
     ALWAYS_INLINE void set_count_defaulted(usize in_count)
     {
         const usize current_count = m_count;
-        set_count_uninitialized();
+        set_count_uninitialized(in_count);
 
         // If the new count is greater than the current count the last `in_count - current_count` elements
         // must be initialized (using their default constructor). Note that if this is not the case, this loop does nothing.
@@ -310,7 +329,7 @@ public:
     ALWAYS_INLINE void set_count(usize in_count, const T& constructor_element)
     {
         const usize current_count = m_count;
-        set_count_uninitialized();
+        set_count_uninitialized(in_count);
 
         // If the new count is greater than the current count the last `in_count - current_count` elements
         // must be initialized (using their copy constructor). Note that if this is not the case, this loop does nothing.
@@ -327,56 +346,50 @@ public:
 
 private:
     // Allocates a memory block large enough to store `in_capacity` elements.
-    NODISCARD ALWAYS_INLINE static T* allocate_memory(usize in_capacity)
+    NODISCARD ALWAYS_INLINE T* allocate_memory(usize in_capacity)
     {
         const usize allocation_size = in_capacity * sizeof(T);
-        void* memory_block = ::operator new(allocation_size);
+        void* memory_block = m_allocator.allocate(allocation_size, alignof(T));
         return static_cast<T*>(memory_block);
     }
 
     // Releases a memory block large enough to store `in_capacity` elements located at address `in_elements`.
-    ALWAYS_INLINE static void release_memory(T* in_elements, usize in_capacity)
+    ALWAYS_INLINE void release_memory(T* in_elements, usize in_capacity)
     {
-        MAYBE_UNUSED const usize allocation_size = in_capacity * sizeof(T);
-        ::operator delete(in_elements);
+        if (!in_elements)
+            return;
+
+        const usize allocation_size = in_capacity * sizeof(T);
+        m_allocator.release(in_elements, allocation_size, alignof(T));
     }
 
     //
-    // Calculates the next capacity of the vector when an expansion is requested.
-    // By default, the vector will try to increase its capacity using the provided growth factor. If the
-    // capacity calculated given by the geometric series is not sufficient, the next capacity will be the minimum required.
+    // Tries to grow the current memory block such that it can store `in_capacity` elements, without moving the elements.
+    // Returns false if the allocator can't grow the block in place, in which case a new block must be allocated.
     //
-    NODISCARD ALWAYS_INLINE static usize calculate_next_capacity(usize required_capacity, usize current_capacity)
+    NODISCARD ALWAYS_INLINE bool try_expand_memory_in_place(usize in_capacity)
     {
-        const usize next_geometric_capacity = (current_capacity * growth_factor_numerator) / growth_factor_denominator;
-        if (next_geometric_capacity > required_capacity)
-            return next_geometric_capacity;
-        return required_capacity;
-    }
+        if (!m_elements)
+            return false;
 
-    // Copies `element_count` elements from the `source_elements` buffer to the `destination_elements` buffer using their
-    // copy constructor.
-    ALWAYS_INLINE static void copy_elements(T* destination_elements, const T* source_elements, usize element_count)
-    {
-        for (usize index = 0; index < element_count; ++index)
-            new (destination_elements + index) T(source_elements[index]);
-    }
+        const usize old_allocation_size = m_capacity * sizeof(T);
+        const usize new_allocation_size = in_capacity * sizeof(T);
+        if (!m_allocator.try_expand_in_place(m_elements, old_allocation_size, new_allocation_size))
+            return false;
 
-    // Moves `element_count` elements from the `source_elements` buffer to the `destination_elements` buffer using their
-    // move constructor and deleted the elements stored in the `source_elements` buffer.
-    ALWAYS_INLINE static void move_elements(T* destination_elements, T* source_elements, usize element_count)
-    {
-        for (usize index = 0; index < element_count; ++index)
-        {
-            new (destination_elements + index) T(move(source_elements[index]));
-            source_elements[index].~T();
-        }
+        m_capacity = in_capacity;
+        return true;
     }
 
 private:
     T* m_elements;
     usize m_capacity;
     usize m_count;
+    NO_UNIQUE_ADDRESS AllocatorType m_allocator;
 };
 
+// The vector doesn't store pointers to itself, so it can be relocated by copying its bytes.
+template<typename T, typename AllocatorType>
+constexpr bool is_trivially_relocatable<Vector<T, AllocatorType>> = true;
+
 } // namespace CaveGame
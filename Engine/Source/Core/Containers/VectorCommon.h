@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+#include <Core/Memory/MemoryOperations.h>
+
+#include <new>
+
+namespace CaveGame
+{
+
+//
+// The growth policy and the element management helpers shared by `Vector` and `InlineVector`.
+//
+namespace Detail
+{
+
+static constexpr usize vector_growth_factor_numerator = 3;
+static constexpr usize vector_growth_factor_denominator = 2;
+// NOTE: The growth factor must always be strictly greater than one, otherwise the vector
+// will always expand by only one element, no matter its size. This can create performance issues.
+static_assert(vector_growth_factor_numerator > vector_growth_factor_denominator);
+
+//
+// Calculates the next capacity of a vector when an expansion is requested.
+// By default, the vector will try to increase its capacity using the growth factor. If the capacity
+// calculated given by the geometric series is not sufficient, the next capacity will be the minimum required.
+//
+NODISCARD ALWAYS_INLINE constexpr usize calculate_next_vector_capacity(usize required_capacity, usize current_capacity)
+{
+    const usize next_geometric_capacity = (current_capacity * vector_growth_factor_numerator) / vector_growth_factor_denominator;
+    if (next_geometric_capacity > required_capacity)
+        return next_geometric_capacity;
+    return required_capacity;
+}
+
+// Copies `element_count` elements from the `source_elements` buffer to the `destination_elements` buffer using their
+// copy constructor. Trivially copyable elements are copied in bulk.
+template<typename T>
+ALWAYS_INLINE void copy_vector_elements(T* destination_elements, const T* source_elements, usize element_count)
+{
+    if constexpr (is_trivially_copyable<T>)
+    {
+        if (element_count > 0)
+            copy_memory(destination_elements, source_elements, element_count * sizeof(T));
+    }
+    else
+    {
+        for (usize index = 0; index < element_count; ++index)
+            new (destination_elements + index) T(source_elements[index]);
+    }
+}
+
+// Moves `element_count` elements from the `source_elements` buffer to the `destination_elements` buffer using their
+// move constructor and deletes the elements stored in the `source_elements` buffer.
+// Trivially relocatable elements are moved in bulk and the destructors of the source elements are not invoked.
+template<typename T>
+ALWAYS_INLINE void move_vector_elements(T* destination_elements, T* source_elements, usize element_count)
+{
+    if constexpr (is_trivially_relocatable<T>)
+    {
+        if (element_count > 0)
+            copy_memory(destination_elements, source_elements, element_count * sizeof(T));
+    }
+    else
+    {
+        for (usize index = 0; index < element_count; ++index)
+        {
+            new (destination_elements + index) T(move(source_elements[index]));
+            source_elements[index].~T();
+        }
+    }
+}
+
+// Destroys `element_count` elements stored in the `elements` buffer. Nothing is executed for trivially destructible elements.
+template<typename T>
+ALWAYS_INLINE void destroy_vector_elements(T* elements, usize element_count)
+{
+    if constexpr (!is_trivially_destructible<T>)
+    {
+        for (usize index = 0; index < element_count; ++index)
+            elements[index].~T();
+    }
+}
+
+} // namespace Detail
+
+} // namespace CaveGame
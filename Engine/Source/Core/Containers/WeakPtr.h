@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/Containers/RefPtr.h>
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+//
+// Container that holds a non-owning reference to an object managed by RefPtr's. The weak pointer doesn't keep the
+// object alive, but it can be promoted to a RefPtr as long as the object hasn't been destroyed.
+// The provided template parameter type must be derived from `RefCounted`, otherwise a static assert will be issued.
+//
+// This allows caches to evict resources while other systems still hold references to them, without pinning memory.
+//
+template<typename T>
+class WeakPtr
+{
+public:
+    ALWAYS_INLINE WeakPtr()
+        : m_control_block(nullptr)
+    {}
+
+    ALWAYS_INLINE WeakPtr(const RefPtr<T>& strong_reference)
+        : m_control_block(nullptr)
+    {
+        static_assert(is_derived_from<T, RefCounted>, "T must be derived from RefCounted!");
+        if (strong_reference.is_valid())
+            m_control_block = strong_reference.m_instance->acquire_weak_control_block();
+    }
+
+    ALWAYS_INLINE WeakPtr(const WeakPtr& other)
+        : m_control_block(other.m_control_block)
+    {
+        if (m_control_block)
+            m_control_block->increment_weak_reference_count();
+    }
+
+    ALWAYS_INLINE WeakPtr(WeakPtr&& other) noexcept
+        : m_control_block(other.m_control_block)
+    {
+        other.m_control_block = nullptr;
+    }
+
+    ALWAYS_INLINE ~WeakPtr() { release(); }
+
+    ALWAYS_INLINE WeakPtr& operator=(const WeakPtr& other)
+    {
+        // Handle self-assignment case.
+        if (this == &other)
+            return *this;
+
+        release();
+        m_control_block = other.m_control_block;
+        if (m_control_block)
+            m_control_block->increment_weak_reference_count();
+
+        return *this;
+    }
+
+    ALWAYS_INLINE WeakPtr& operator=(WeakPtr&& other) noexcept
+    {
+        // Handle self-assignment case.
+        if (this == &other)
+            return *this;
+
+        release();
+        m_control_block = other.m_control_block;
+        other.m_control_block = nullptr;
+
+        return *this;
+    }
+
+public:
+    //
+    // Returns whether or not the referenced object has been destroyed (or the weak pointer doesn't reference any object).
+    // NOTE: The object might be destroyed by another thread right after this function returns false, so `promote()`
+    // should be used (and its result checked) when the object is going to be accessed.
+    //
+    NODISCARD ALWAYS_INLINE bool is_expired() const { return !m_control_block || !m_control_block->is_object_alive(); }
+
+    //
+    // Returns a RefPtr to the referenced object, which keeps the object alive for as long as it exists.
+    // If the object has already been destroyed, an invalid RefPtr is returned.
+    //
+    NODISCARD ALWAYS_INLINE RefPtr<T> promote() const
+    {
+        if (!m_control_block)
+            return {};
+
+        RefCounted* ref_counted = m_control_block->try_take_strong_reference();
+        if (!ref_counted)
+            return {};
+
+        // The reference count has already been incremented by the control block.
+        return RefPtr<T>(static_cast<T*>(ref_counted), typename RefPtr<T>::AlreadyReferencedTag());
+    }
+
+    // Invalidates the weak pointer. The referenced object (if any) is not affected.
+    ALWAYS_INLINE void release()
+    {
+        if (m_control_block)
+        {
+            m_control_block->release_weak_reference();
+            m_control_block = nullptr;
+        }
+    }
+
+private:
+    Detail::WeakReferenceControlBlock* m_control_block;
+};
+
+// A weak pointer only stores the address of the control block, so it can be relocated by copying its bytes.
+template<typename T>
+constexpr bool is_trivially_relocatable<WeakPtr<T>> = true;
+
+} // namespace CaveGame
@@ -20,11 +20,15 @@
     #define CAVE_PLATFORM_WINDOWS 0
 #endif // CAVE_PLATFORM_WINDOWS
 
+#ifndef CAVE_PLATFORM_LINUX
+    #define CAVE_PLATFORM_LINUX 0
+#endif // CAVE_PLATFORM_LINUX
+
 //
 // Ensure that at least one platform macro is set to 1.
 // Otherwise, the project configuration is wrong and a compiler error should be raised.
 //
-#if !CAVE_PLATFORM_WINDOWS
+#if !CAVE_PLATFORM_WINDOWS && !CAVE_PLATFORM_LINUX
     #error Unknown or unsupported platform!
 #endif // Any supported platform.
 
@@ -93,6 +97,26 @@
     #error Unknown or unsupported compiler!
 #endif // Any supported compiler.
 
+//======================================================================================
+// ARCHITECTURE CONFIGURATION MACROS.
+//======================================================================================
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #define CAVE_ARCHITECTURE_X64 1
+#endif // defined(_M_X64) || defined(__x86_64__)
+
+#if defined(_M_ARM64) || defined(__aarch64__)
+    #define CAVE_ARCHITECTURE_ARM64 1
+#endif // defined(_M_ARM64) || defined(__aarch64__)
+
+#ifndef CAVE_ARCHITECTURE_X64
+    #define CAVE_ARCHITECTURE_X64 0
+#endif // CAVE_ARCHITECTURE_X64
+
+#ifndef CAVE_ARCHITECTURE_ARM64
+    #define CAVE_ARCHITECTURE_ARM64 0
+#endif // CAVE_ARCHITECTURE_ARM64
+
 //======================================================================================
 // UTILITY (GENERAL PURPOSE) MACROS.
 //======================================================================================
@@ -101,13 +125,44 @@
     // Hint for the compiler that the function should always be inlined.
     #define ALWAYS_INLINE __forceinline
 
+    // Prevents the compiler from inlining the function.
+    #define NOINLINE __declspec(noinline)
+
     // Traps the debugger. Triggers a breakpoint if a debugger is attached or crashes the program otherwise.
     #define CAVE_DEBUGBREAK __debugbreak()
 
     // Expands to the signature of the function in which the macro is located.
     #define CAVE_FUNCTION __FUNCSIG__
+
+    // Allows the function to use AVX2 instructions, even if the translation unit isn't compiled with AVX2 enabled.
+    // MSVC always allows the use of the AVX2 intrinsics, so no annotation is required.
+    #define CAVE_TARGET_AVX2
+
+    // Allows an empty data member to occupy no storage. MSVC ignores the standard attribute for ABI compatibility reasons.
+    #define NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
 #endif // CAVE_COMPILER_MSVC
 
+#if CAVE_COMPILER_CLANG || CAVE_COMPILER_GCC
+    // Hint for the compiler that the function should always be inlined.
+    #define ALWAYS_INLINE inline __attribute__((always_inline))
+
+    // Prevents the compiler from inlining the function.
+    #define NOINLINE __attribute__((noinline))
+
+    // Traps the debugger. Triggers a breakpoint if a debugger is attached or crashes the program otherwise.
+    #define CAVE_DEBUGBREAK __builtin_trap()
+
+    // Expands to the signature of the function in which the macro is located.
+    #define CAVE_FUNCTION __PRETTY_FUNCTION__
+
+    // Allows the function to use AVX2 instructions, even if the translation unit isn't compiled with AVX2 enabled.
+    // The caller is responsible for checking that the CPU supports AVX2 before invoking such a function.
+    #define CAVE_TARGET_AVX2 __attribute__((target("avx2")))
+
+    // Allows an empty data member to occupy no storage.
+    #define NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif // CAVE_COMPILER_CLANG || CAVE_COMPILER_GCC
+
 // The compiler is encouraged to issue a warning if the function return value is not stored/used.
 #define NODISCARD [[nodiscard]]
 
@@ -45,6 +45,42 @@ using intptr = i64;
 } // namespace CaveGame
 #endif // CAVE_PLATFORM_WINDOWS
 
+#if CAVE_PLATFORM_LINUX
+namespace CaveGame
+{
+
+//
+// Fixed-size primitive types that represent an unsigned integer.
+// Their sizes can always be assumed as they are guaranteed to be the same on all platforms.
+//
+using u8 = unsigned char;
+using u16 = unsigned short;
+using u32 = unsigned int;
+using u64 = unsigned long long;
+
+//
+// Fixed-size primitive types that represent an signed integer.
+// Their sizes can always be assumed as they are guaranteed to be the same on all platforms.
+//
+using i8 = signed char;
+using i16 = signed short;
+using i32 = signed int;
+using i64 = signed long long;
+
+//
+// Primitive types that represent integers which hold a size or memory address.
+// Never assume their sizes, as they are not guaranteed to be the same on all platforms.
+// NOTE: On LP64 platforms `size_t` is `unsigned long`, which is a distinct type from `u64`. Using it
+// here is required, as some language constructs (such as literal operators) expect exactly `size_t`.
+//
+using usize = unsigned long;
+using ssize = signed long;
+using uintptr = unsigned long;
+using intptr = signed long;
+
+} // namespace CaveGame
+#endif // CAVE_PLATFORM_LINUX
+
 // Marks the type in which this macro is placed as non-copyable, by marking the
 // copy constructor and assignment operator as deleted.
 #define CAVE_MAKE_NONCOPYABLE(type_name)  \
@@ -99,6 +135,28 @@ constexpr bool is_derived_from = std::is_base_of_v<BaseType, DerivedType>;
 template<typename BaseType, typename DerivedType>
 constexpr bool is_base_of = std::is_base_of_v<BaseType, DerivedType>;
 
+// Wrapper around `std::is_same_v`.
+template<typename T, typename U>
+constexpr bool is_same = std::is_same_v<T, U>;
+
+// Wrapper around `std::is_trivially_copyable_v`.
+template<typename T>
+constexpr bool is_trivially_copyable = std::is_trivially_copyable_v<T>;
+
+// Wrapper around `std::is_trivially_destructible_v`.
+template<typename T>
+constexpr bool is_trivially_destructible = std::is_trivially_destructible_v<T>;
+
+//
+// A type is trivially relocatable if moving an instance to a new address and destroying the original is equivalent
+// to copying its bytes and *not* running the destructor of the original. Containers use this to relocate their
+// elements using bulk memory copies.
+// All trivially copyable types are trivially relocatable. Other types (such as owning pointers, which don't store
+// pointers to themselves) can opt in by specializing this variable template.
+//
+template<typename T>
+constexpr bool is_trivially_relocatable = std::is_trivially_copyable_v<T>;
+
 //
 // Remove the pointer from a type.
 // For example, `const int*` becomes `const int`, while `float` remains `float`.
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Hash/Hash.h>
+
+#include <cstring>
+
+namespace CaveGame
+{
+
+// The default secret of the wyhash algorithm (final version 4).
+static constexpr u64 wyhash_secret[4] = {
+    0x2D358DCCAA6C78A5ULL,
+    0x8BB84B93962EACC9ULL,
+    0x4B33A62ED433D4A3ULL,
+    0x4D5A2DA51DE1AA47ULL,
+};
+
+//
+// Unaligned little-endian reads. The copies are recognized by the compilers and replaced by a single load instruction.
+//
+
+NODISCARD ALWAYS_INLINE static u64 read_u64(const u8* data)
+{
+    u64 value;
+    std::memcpy(&value, data, sizeof(u64));
+    return value;
+}
+
+NODISCARD ALWAYS_INLINE static u64 read_u32(const u8* data)
+{
+    u32 value;
+    std::memcpy(&value, data, sizeof(u32));
+    return value;
+}
+
+// Reads between one and three bytes, such that every byte affects the result.
+NODISCARD ALWAYS_INLINE static u64 read_small(const u8* data, usize byte_count)
+{
+    return (static_cast<u64>(data[0]) << 16) | (static_cast<u64>(data[byte_count >> 1]) << 8) | data[byte_count - 1];
+}
+
+u64 Hash::bytes(const void* data, usize byte_count, u64 seed)
+{
+    const u8* bytes = static_cast<const u8*>(data);
+    seed ^= multiply_mix(seed ^ wyhash_secret[0], wyhash_secret[1]);
+
+    u64 a;
+    u64 b;
+    if (byte_count <= 16)
+    {
+        if (byte_count >= 4)
+        {
+            // Two overlapping pairs of 32-bit reads cover all inputs between 4 and 16 bytes.
+            const usize middle_offset = (byte_count >> 3) << 2;
+            a = (read_u32(bytes) << 32) | read_u32(bytes + middle_offset);
+            b = (read_u32(bytes + byte_count - 4) << 32) | read_u32(bytes + byte_count - 4 - middle_offset);
+        }
+        else if (byte_count > 0)
+        {
+            a = read_small(bytes, byte_count);
+            b = 0;
+        }
+        else
+        {
+            a = 0;
+            b = 0;
+        }
+    }
+    else
+    {
+        usize remaining_byte_count = byte_count;
+        if (remaining_byte_count > 48)
+        {
+            // Three independent lanes, so that the multiplications can be executed in parallel.
+            u64 lane_1 = seed;
+            u64 lane_2 = seed;
+            do
+            {
+                seed = multiply_mix(read_u64(bytes) ^ wyhash_secret[1], read_u64(bytes + 8) ^ seed);
+                lane_1 = multiply_mix(read_u64(bytes + 16) ^ wyhash_secret[2], read_u64(bytes + 24) ^ lane_1);
+                lane_2 = multiply_mix(read_u64(bytes + 32) ^ wyhash_secret[3], read_u64(bytes + 40) ^ lane_2);
+                bytes += 48;
+                remaining_byte_count -= 48;
+            } while (remaining_byte_count > 48);
+
+            seed ^= lane_1 ^ lane_2;
+        }
+
+        while (remaining_byte_count > 16)
+        {
+            seed = multiply_mix(read_u64(bytes) ^ wyhash_secret[1], read_u64(bytes + 8) ^ seed);
+            bytes += 16;
+            remaining_byte_count -= 16;
+        }
+
+        // The last 16 bytes of the input are always read, even if they overlap with the bytes already consumed.
+        a = read_u64(bytes + remaining_byte_count - 16);
+        b = read_u64(bytes + remaining_byte_count - 8);
+    }
+
+    a ^= wyhash_secret[1];
+    b ^= seed;
+#if CAVE_COMPILER_MSVC && CAVE_ARCHITECTURE_X64
+    u64 high;
+    a = _umul128(a, b, &high);
+    b = high;
+#elif CAVE_COMPILER_MSVC
+    const u64 low = a * b;
+    b = __umulh(a, b);
+    a = low;
+#else
+    const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    a = static_cast<u64>(product);
+    b = static_cast<u64>(product >> 64);
+#endif // CAVE_COMPILER_MSVC && CAVE_ARCHITECTURE_X64
+
+    return multiply_mix(a ^ wyhash_secret[0] ^ byte_count, b ^ wyhash_secret[1]);
+}
+
+} // namespace CaveGame
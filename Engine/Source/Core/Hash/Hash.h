@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+
+#if CAVE_COMPILER_MSVC
+    #include <intrin.h>
+#endif // CAVE_COMPILER_MSVC
+
+namespace CaveGame
+{
+
+//
+// Fast, non-cryptographic hash functions. They are designed for hash tables and checksums of in-memory data,
+// so they must never be used where resistance against malicious inputs is required.
+// The results are stable across runs, but not necessarily across engine versions, so they must not be serialized.
+//
+class Hash
+{
+public:
+    //
+    // Computes the 64-bit hash of a sequence of bytes, based on the wyhash algorithm (final version 4).
+    // Long inputs are consumed in blocks of 48 bytes using three independent multiply-mix lanes, which keeps the
+    // throughput close to the memory bandwidth for the sizes a game engine commonly hashes.
+    //
+    NODISCARD static u64 bytes(const void* data, usize byte_count, u64 seed = 0);
+
+    //
+    // Computes the hash of a UTF-8 string. Equivalent to `Hash::bytes`, except that the result is never zero, so that zero
+    // can be used as the "not computed yet" value by the structures that cache string hashes.
+    //
+    NODISCARD ALWAYS_INLINE static u64 string(const char* characters, usize byte_count)
+    {
+        const u64 hash = bytes(characters, byte_count);
+        return (hash != 0) ? hash : 1;
+    }
+
+public:
+    //
+    // Multiplies the two values (producing a 128-bit result) and folds the high half into the low half.
+    // This is the core mixing primitive of the wyhash family of hash functions.
+    //
+    NODISCARD ALWAYS_INLINE static u64 multiply_mix(u64 a, u64 b)
+    {
+#if CAVE_COMPILER_MSVC && CAVE_ARCHITECTURE_X64
+        u64 high;
+        const u64 low = _umul128(a, b, &high);
+        return low ^ high;
+#elif CAVE_COMPILER_MSVC
+        return (a * b) ^ __umulh(a, b);
+#else
+        const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+        return static_cast<u64>(product) ^ static_cast<u64>(product >> 64);
+#endif // CAVE_COMPILER_MSVC && CAVE_ARCHITECTURE_X64
+    }
+
+    //
+    // Mixes the bits of a 32-bit integer, such that every input bit affects every output bit (the "lowbias32" mixer).
+    // The function is a bijection, so distinct inputs always produce distinct outputs.
+    //
+    NODISCARD ALWAYS_INLINE static constexpr u32 integer(u32 value)
+    {
+        value ^= value >> 16;
+        value *= 0x7FEB352DU;
+        value ^= value >> 15;
+        value *= 0x846CA68BU;
+        value ^= value >> 16;
+        return value;
+    }
+
+    //
+    // Mixes the bits of a 64-bit integer, such that every input bit affects every output bit (the "moremur" mixer).
+    // The function is a bijection, so distinct inputs always produce distinct outputs.
+    //
+    NODISCARD ALWAYS_INLINE static constexpr u64 integer(u64 value)
+    {
+        value ^= value >> 27;
+        value *= 0x3C79AC492BA7B653ULL;
+        value ^= value >> 33;
+        value *= 0x1C69B3F74AC4AE35ULL;
+        value ^= value >> 27;
+        return value;
+    }
+
+    //
+    // Computes the 64-bit hash of a three-dimensional integer coordinate (for example, the position of a chunk or voxel).
+    // Neighbouring coordinates produce unrelated hashes, so the coordinates can be used directly as hash table keys.
+    //
+    NODISCARD ALWAYS_INLINE static u64 coordinates(i32 x, i32 y, i32 z)
+    {
+        const u64 xy = (static_cast<u64>(static_cast<u32>(x)) << 32) | static_cast<u32>(y);
+        const u64 z_seeded = static_cast<u64>(static_cast<u32>(z)) ^ 0x8BB84B93962EACC9ULL;
+        return integer(multiply_mix(xy ^ 0x2D358DCCAA6C78A5ULL, z_seeded));
+    }
+
+    //
+    // Combines two hashes into a single one. The combination is not commutative, so the order of the hashes matters.
+    //
+    NODISCARD ALWAYS_INLINE static u64 combine(u64 hash, u64 other_hash)
+    {
+        return multiply_mix(hash ^ 0x4B33A62ED433D4A3ULL, other_hash ^ 0x4D5A2DA51DE1AA47ULL);
+    }
+};
+
+//
+// The default hasher used by the hash containers. A hasher is a type that provides a static `hash` function,
+// which computes a 64-bit hash for a key. The hash must be well distributed across all 64 bits, as the low bits
+// select the slot where the key is stored, while the high bits are stored in the control bytes.
+// Custom key types can either specialize this template or provide their own hasher type to the containers.
+//
+template<typename T>
+struct Hasher
+{
+    static_assert(std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>, "No hasher is available for this key type.");
+
+    NODISCARD ALWAYS_INLINE static u64 hash(T key)
+    {
+        if constexpr (std::is_pointer_v<T>)
+            return Hash::integer(static_cast<u64>(reinterpret_cast<uintptr>(key)));
+        else
+            return Hash::integer(static_cast<u64>(key));
+    }
+};
+
+} // namespace CaveGame
@@ -0,0 +1,613 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Vector.h>
+#include <Core/Jobs/JobSystem.h>
+#include <Core/Jobs/WorkStealingDeque.h>
+#include <Core/Memory/PoolAllocator.h>
+#include <Core/Platform/Fiber.h>
+#include <Core/Platform/PlatformCore.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//
+// When set to 0, the worker threads execute the jobs directly on their own stacks and a job that waits for a counter
+// executes other jobs until the counter reaches zero, exactly like the main thread does.
+//
+#ifndef CAVE_ENABLE_JOB_FIBERS
+    #define CAVE_ENABLE_JOB_FIBERS 1
+#endif // CAVE_ENABLE_JOB_FIBERS
+
+namespace CaveGame
+{
+
+// The maximum number of jobs stored in the deque of a thread. The jobs that don't fit are pushed to the shared queue.
+static constexpr u32 job_deque_capacity = 4096;
+
+// The number of times an idle worker looks for jobs (pausing the processor in between) before going to sleep.
+static constexpr u32 idle_spin_count = 256;
+
+//
+// The number of job fibers created in addition to the one required by each worker thread, which bounds the number of
+// jobs that can be parked at the same time. When no fiber is available, the waiting job executes other jobs instead.
+//
+static constexpr u32 parked_job_fiber_count = 128;
+
+static constexpr usize job_fiber_stack_byte_count = 256 * KiB;
+
+using JobDeque = WorkStealingDeque<Detail::Job*, job_deque_capacity>;
+
+namespace Detail
+{
+
+struct JobFiber
+{
+    Fiber fiber;
+    // The next fiber in the free list, in the ready queue or in the waiting list of a counter.
+    JobFiber* next { nullptr };
+};
+
+} // namespace Detail
+
+struct JobThreadData
+{
+    JobDeque deque;
+    std::thread thread;
+    // The state of the random number generator used to select the threads to steal jobs from.
+    u32 random_state { 0 };
+
+    // The fiber of the worker thread itself, which only runs before the first and after the last job fiber.
+    Fiber thread_fiber;
+    // The job fiber currently executing on the thread. Null for the threads that don't execute jobs on fibers.
+    Detail::JobFiber* current_fiber { nullptr };
+
+    //
+    // The actions requested by the fiber that the thread has switched away from, which are performed by the fiber that
+    // has been switched to. They can't be performed before the switch, as another thread could otherwise resume the
+    // suspended fiber before its context has been saved.
+    //
+    Detail::JobFiber* fiber_to_release { nullptr };
+    Detail::JobFiber* fiber_to_park { nullptr };
+    const JobCounter* park_counter { nullptr };
+};
+
+struct JobSystemData
+{
+    u32 thread_count { 0 };
+    JobThreadData* threads { nullptr };
+    PoolAllocator<Detail::Job> job_pool;
+
+    // Jobs scheduled by threads that are not owned by the job system, or that didn't fit in the deque of their thread.
+    std::mutex shared_queue_mutex;
+    Vector<Detail::Job*> shared_queue;
+
+    //
+    // The number of jobs that have been scheduled but not started yet. An idle worker only goes to sleep if this is zero.
+    // The count is incremented before a job is pushed, so it might briefly be larger than the number of stored jobs.
+    //
+    std::atomic<i64> queued_job_count { 0 };
+
+    std::mutex sleep_mutex;
+    std::condition_variable wake_condition;
+    std::atomic<u32> sleeping_thread_count { 0 };
+    bool is_shutting_down { false };
+
+    Detail::JobFiber* fibers { nullptr };
+    // The number of fibers whose stack has been successfully allocated.
+    u32 fiber_count { 0 };
+
+    //
+    // The fibers that are not executing and not parked, and the parked fibers whose counter has reached zero.
+    // The ready fibers are counted in the queued job count, as resuming them is the same as starting a job.
+    //
+    std::mutex fiber_mutex;
+    Detail::JobFiber* first_free_fiber { nullptr };
+    u32 free_fiber_count { 0 };
+    Detail::JobFiber* first_ready_fiber { nullptr };
+    Detail::JobFiber* last_ready_fiber { nullptr };
+    std::atomic<u32> ready_fiber_count { 0 };
+};
+
+static JobSystemData* s_job_system;
+static thread_local u32 s_current_thread_index = JobSystem::invalid_thread_index;
+
+//
+// Returns the index of the calling thread.
+// NOTE: The compiler assumes that a function always runs on the same thread, so it is allowed to cache the address of
+// a thread-local variable across a call that switches fibers. As a fiber can be resumed on a different thread, the
+// code that switches fibers must read the thread index through this function, which is never inlined.
+//
+NOINLINE static u32 load_current_thread_index()
+{
+    return s_current_thread_index;
+}
+
+//
+// Returns the next value produced by the xorshift random number generator of the given thread.
+// Stealing from random threads spreads the thieves across the deques, instead of contending on the same one.
+//
+NODISCARD ALWAYS_INLINE static u32 get_next_random_value(JobThreadData& thread_data)
+{
+    u32 state = thread_data.random_state;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    thread_data.random_state = state;
+    return state;
+}
+
+// Wakes up one of the sleeping worker threads, if any, after a job has been queued.
+static void wake_sleeping_worker()
+{
+    if (s_job_system->sleeping_thread_count.load(std::memory_order_seq_cst) > 0)
+    {
+        // NOTE: The mutex must be locked, otherwise the notification could be sent after the worker has checked the
+        // queued job count but before it has started waiting, in which case it would be lost.
+        std::scoped_lock lock(s_job_system->sleep_mutex);
+        s_job_system->wake_condition.notify_one();
+    }
+}
+
+// Finds a job to be executed by the given thread, or returns nullptr if there are no jobs available.
+NODISCARD static Detail::Job* find_job(u32 thread_index)
+{
+    Detail::Job* job = nullptr;
+    if (thread_index != JobSystem::invalid_thread_index)
+        job = s_job_system->threads[thread_index].deque.pop();
+
+    if (!job)
+    {
+        const u32 thread_count = s_job_system->thread_count;
+        const u32 first_victim_index =
+            (thread_index != JobSystem::invalid_thread_index) ? get_next_random_value(s_job_system->threads[thread_index]) % thread_count : 0;
+
+        for (u32 offset = 0; offset < thread_count && !job; ++offset)
+        {
+            const u32 victim_index = (first_victim_index + offset) % thread_count;
+            if (victim_index != thread_index)
+                job = s_job_system->threads[victim_index].deque.steal();
+        }
+    }
+
+    if (!job)
+    {
+        std::scoped_lock lock(s_job_system->shared_queue_mutex);
+        if (!s_job_system->shared_queue.is_empty())
+        {
+            job = s_job_system->shared_queue.last();
+            s_job_system->shared_queue.set_count_uninitialized(s_job_system->shared_queue.count() - 1);
+        }
+    }
+
+    if (job)
+        s_job_system->queued_job_count.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+}
+
+NODISCARD static Detail::JobFiber* acquire_free_fiber()
+{
+    std::scoped_lock lock(s_job_system->fiber_mutex);
+    Detail::JobFiber* fiber = s_job_system->first_free_fiber;
+    if (fiber)
+    {
+        s_job_system->first_free_fiber = fiber->next;
+        --s_job_system->free_fiber_count;
+    }
+    return fiber;
+}
+
+static void release_fiber(Detail::JobFiber* fiber)
+{
+    std::scoped_lock lock(s_job_system->fiber_mutex);
+    fiber->next = s_job_system->first_free_fiber;
+    s_job_system->first_free_fiber = fiber;
+    ++s_job_system->free_fiber_count;
+}
+
+static void push_ready_fiber(Detail::JobFiber* fiber)
+{
+    s_job_system->queued_job_count.fetch_add(1, std::memory_order_seq_cst);
+    {
+        std::scoped_lock lock(s_job_system->fiber_mutex);
+        fiber->next = nullptr;
+        if (s_job_system->last_ready_fiber)
+            s_job_system->last_ready_fiber->next = fiber;
+        else
+            s_job_system->first_ready_fiber = fiber;
+        s_job_system->last_ready_fiber = fiber;
+        s_job_system->ready_fiber_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    wake_sleeping_worker();
+}
+
+// Returns the parked fiber that has been ready for the longest time, or nullptr if there are no ready fibers.
+NODISCARD static Detail::JobFiber* pop_ready_fiber()
+{
+    // Avoid locking the mutex each time a worker looks for work, as there are usually no ready fibers.
+    if (s_job_system->ready_fiber_count.load(std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    Detail::JobFiber* fiber = nullptr;
+    {
+        std::scoped_lock lock(s_job_system->fiber_mutex);
+        fiber = s_job_system->first_ready_fiber;
+        if (!fiber)
+            return nullptr;
+
+        s_job_system->first_ready_fiber = fiber->next;
+        if (!s_job_system->first_ready_fiber)
+            s_job_system->last_ready_fiber = nullptr;
+        s_job_system->ready_fiber_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    s_job_system->queued_job_count.fetch_sub(1, std::memory_order_relaxed);
+    return fiber;
+}
+
+//
+// Waits until a job is queued, by spinning for a short while and then sleeping.
+// Returns false if the job system is shutting down and there are no more jobs to execute.
+//
+NODISCARD static bool wait_for_queued_job()
+{
+    // Spin for a short while before going to sleep, as jobs are usually scheduled in bursts.
+    u32 spin_index = 0;
+    while (spin_index < idle_spin_count && s_job_system->queued_job_count.load(std::memory_order_relaxed) <= 0)
+    {
+        PlatformCore::pause_processor();
+        ++spin_index;
+    }
+    if (spin_index < idle_spin_count)
+        return true;
+
+    //
+    // NOTE: The sleeping thread count is incremented before the queued job count is checked, while the scheduling
+    // threads increment the queued job count before checking the sleeping thread count. Both are sequentially
+    // consistent, so either this thread sees the new job or the scheduling thread sees this thread sleeping.
+    //
+    std::unique_lock lock(s_job_system->sleep_mutex);
+    s_job_system->sleeping_thread_count.fetch_add(1, std::memory_order_seq_cst);
+    while (s_job_system->queued_job_count.load(std::memory_order_seq_cst) <= 0 && !s_job_system->is_shutting_down)
+        s_job_system->wake_condition.wait(lock);
+    s_job_system->sleeping_thread_count.fetch_sub(1, std::memory_order_relaxed);
+
+    return !(s_job_system->is_shutting_down && s_job_system->queued_job_count.load(std::memory_order_relaxed) <= 0);
+}
+
+void JobSystem::worker_thread_main(u32 thread_index)
+{
+    s_current_thread_index = thread_index;
+    MAYBE_UNUSED JobThreadData& thread_data = s_job_system->threads[thread_index];
+
+#if CAVE_ENABLE_JOB_FIBERS
+    //
+    // The thread switches to a job fiber, which executes jobs until the job system shuts down. At that point, whichever
+    // job fiber is executing on the thread switches back to the thread fiber.
+    // NOTE: If the thread can't be converted to a fiber or there is no free fiber, it executes the jobs on its own stack.
+    //
+    if (thread_data.thread_fiber.initialize_from_current_thread())
+    {
+        Detail::JobFiber* fiber = acquire_free_fiber();
+        if (fiber)
+        {
+            thread_data.current_fiber = fiber;
+            thread_data.thread_fiber.switch_to(fiber->fiber);
+            complete_fiber_switch();
+            thread_data.thread_fiber.shutdown();
+            return;
+        }
+
+        thread_data.thread_fiber.shutdown();
+    }
+#endif // CAVE_ENABLE_JOB_FIBERS
+
+    while (true)
+    {
+        Detail::Job* job = find_job(thread_index);
+        if (job)
+            execute_job(job);
+        else if (!wait_for_queued_job())
+            return;
+    }
+}
+
+void JobSystem::job_fiber_main(void* user_data)
+{
+    Detail::JobFiber* self = static_cast<Detail::JobFiber*>(user_data);
+
+    while (true)
+    {
+        // The fiber might be running on a different thread after each iteration, as executing a job can park it.
+        complete_fiber_switch();
+        const u32 thread_index = load_current_thread_index();
+        JobThreadData& thread_data = s_job_system->threads[thread_index];
+
+        // Resuming the parked jobs takes priority over starting new ones, as it allows their memory to be released.
+        Detail::JobFiber* ready_fiber = pop_ready_fiber();
+        if (ready_fiber)
+        {
+            thread_data.fiber_to_release = self;
+            thread_data.current_fiber = ready_fiber;
+            self->fiber.switch_to(ready_fiber->fiber);
+            continue;
+        }
+
+        Detail::Job* job = find_job(thread_index);
+        if (job)
+        {
+            execute_job(job);
+            continue;
+        }
+
+        if (!wait_for_queued_job())
+        {
+            thread_data.fiber_to_release = self;
+            thread_data.current_fiber = nullptr;
+            self->fiber.switch_to(thread_data.thread_fiber);
+        }
+    }
+}
+
+void JobSystem::complete_fiber_switch()
+{
+    JobThreadData& thread_data = s_job_system->threads[load_current_thread_index()];
+
+    if (thread_data.fiber_to_release)
+    {
+        release_fiber(thread_data.fiber_to_release);
+        thread_data.fiber_to_release = nullptr;
+    }
+
+    if (thread_data.fiber_to_park)
+    {
+        Detail::JobFiber* fiber = thread_data.fiber_to_park;
+        const JobCounter* counter = thread_data.park_counter;
+        thread_data.fiber_to_park = nullptr;
+        thread_data.park_counter = nullptr;
+
+        // The counter might have reached zero after the fiber decided to park, in which case it is resumed immediately.
+        counter->lock();
+        if (counter->m_value.load(std::memory_order_acquire) == 0)
+        {
+            counter->unlock();
+            push_ready_fiber(fiber);
+        }
+        else
+        {
+            fiber->next = counter->m_first_waiting_fiber;
+            counter->m_first_waiting_fiber = fiber;
+            counter->unlock();
+        }
+    }
+}
+
+bool JobSystem::initialize(u32 worker_thread_count)
+{
+    if (s_job_system)
+    {
+        // The job system has already been initialized.
+        return false;
+    }
+
+    if (worker_thread_count == 0)
+    {
+        const u32 processor_count = std::thread::hardware_concurrency();
+        worker_thread_count = (processor_count > 1) ? (processor_count - 1) : 1;
+    }
+
+    s_job_system = new JobSystemData();
+    s_job_system->thread_count = worker_thread_count + 1;
+    s_job_system->threads = new JobThreadData[s_job_system->thread_count];
+    for (u32 thread_index = 0; thread_index < s_job_system->thread_count; ++thread_index)
+        s_job_system->threads[thread_index].random_state = 0x9E3779B9U * (thread_index + 1);
+
+#if CAVE_ENABLE_JOB_FIBERS
+    // NOTE: The fibers whose stack can't be allocated are never used, so the job system works (worse) without them.
+    const u32 fiber_count = worker_thread_count + parked_job_fiber_count;
+    s_job_system->fibers = new Detail::JobFiber[fiber_count];
+    for (u32 fiber_index = 0; fiber_index < fiber_count; ++fiber_index)
+    {
+        Detail::JobFiber& fiber = s_job_system->fibers[fiber_index];
+        if (fiber.fiber.initialize(&JobSystem::job_fiber_main, &fiber, job_fiber_stack_byte_count))
+        {
+            release_fiber(&fiber);
+            ++s_job_system->fiber_count;
+        }
+    }
+#endif // CAVE_ENABLE_JOB_FIBERS
+
+    // The main thread always has the index zero.
+    s_current_thread_index = 0;
+    for (u32 thread_index = 1; thread_index < s_job_system->thread_count; ++thread_index)
+        s_job_system->threads[thread_index].thread = std::thread(&JobSystem::worker_thread_main, thread_index);
+
+    return true;
+}
+
+void JobSystem::shutdown()
+{
+    if (!s_job_system)
+    {
+        // The job system has already been shut down.
+        return;
+    }
+
+    CAVE_ASSERT(load_current_thread_index() == 0);
+
+    // Help the workers execute the jobs that are still scheduled.
+    while (s_job_system->queued_job_count.load(std::memory_order_acquire) > 0)
+    {
+        Detail::Job* job = find_job(0);
+        if (job)
+            execute_job(job);
+        else
+            PlatformCore::pause_processor();
+    }
+
+    {
+        std::scoped_lock lock(s_job_system->sleep_mutex);
+        s_job_system->is_shutting_down = true;
+    }
+    s_job_system->wake_condition.notify_all();
+
+    for (u32 thread_index = 1; thread_index < s_job_system->thread_count; ++thread_index)
+        s_job_system->threads[thread_index].thread.join();
+
+    // All fibers must have been released, as a parked fiber would mean that a job is still waiting for a counter.
+    CAVE_ASSERT(s_job_system->free_fiber_count == s_job_system->fiber_count);
+    delete[] s_job_system->fibers;
+
+    delete[] s_job_system->threads;
+    delete s_job_system;
+    s_job_system = nullptr;
+    s_current_thread_index = invalid_thread_index;
+}
+
+u32 JobSystem::get_thread_count()
+{
+    CAVE_ASSERT(s_job_system);
+    return s_job_system->thread_count;
+}
+
+u32 JobSystem::get_current_thread_index()
+{
+    return load_current_thread_index();
+}
+
+void JobSystem::schedule(JobFunction function, void* user_data, JobCounter* counter)
+{
+    schedule([function, user_data]() { function(user_data); }, counter);
+}
+
+void JobSystem::wait_for_counter(const JobCounter& counter)
+{
+    CAVE_ASSERT(s_job_system);
+
+    while (!counter.is_zero())
+    {
+        // NOTE: The thread index is loaded on every iteration, as executing a job might park and migrate this fiber.
+        const u32 thread_index = load_current_thread_index();
+
+#if CAVE_ENABLE_JOB_FIBERS
+        //
+        // Park the fiber of the waiting job and switch to a fiber that keeps the thread busy: either a parked fiber that
+        // is ready to be resumed or a free fiber, which starts executing jobs. The main thread never parks, such that
+        // the code it executes outside of jobs always stays on the main thread.
+        //
+        if (thread_index != invalid_thread_index && s_job_system->threads[thread_index].current_fiber)
+        {
+            Detail::JobFiber* target_fiber = pop_ready_fiber();
+            if (!target_fiber)
+                target_fiber = acquire_free_fiber();
+
+            if (target_fiber)
+            {
+                JobThreadData& thread_data = s_job_system->threads[thread_index];
+                Detail::JobFiber* waiting_fiber = thread_data.current_fiber;
+                thread_data.fiber_to_park = waiting_fiber;
+                thread_data.park_counter = &counter;
+                thread_data.current_fiber = target_fiber;
+                waiting_fiber->fiber.switch_to(target_fiber->fiber);
+
+                // The fiber has been resumed (possibly on a different thread), which only happens after the counter has
+                // reached zero and the decrementing thread no longer accesses it.
+                complete_fiber_switch();
+                return;
+            }
+        }
+#endif // CAVE_ENABLE_JOB_FIBERS
+
+        Detail::Job* job = find_job(thread_index);
+        if (job)
+        {
+            execute_job(job);
+            continue;
+        }
+
+        // The remaining jobs are executed by other threads.
+        PlatformCore::pause_processor();
+    }
+
+    // NOTE: The thread that brought the counter to zero might still be accessing the list of waiting fibers, so the
+    // counter can only be destroyed after that thread has released its lock.
+    counter.lock();
+    counter.unlock();
+}
+
+void JobSystem::execute_job(Detail::Job* job)
+{
+    job->function(job->data);
+
+    // NOTE: The job is released before the counter is decremented, as the waiting thread might shut down the job system.
+    JobCounter* counter = job->counter;
+    s_job_system->job_pool.release(job);
+
+    if (counter)
+        decrement_counter(counter);
+}
+
+void JobSystem::decrement_counter(JobCounter* counter)
+{
+    // Until the counter reaches zero, no waiting fiber has to be resumed, so the lock isn't needed.
+    u32 value = counter->m_value.load(std::memory_order_relaxed);
+    while (value > 1)
+    {
+        if (counter->m_value.compare_exchange_weak(value, value - 1, std::memory_order_release, std::memory_order_relaxed))
+            return;
+    }
+
+    counter->lock();
+    const u32 previous_value = counter->m_value.fetch_sub(1, std::memory_order_release);
+    Detail::JobFiber* waiting_fiber = nullptr;
+    if (previous_value == 1)
+    {
+        waiting_fiber = counter->m_first_waiting_fiber;
+        counter->m_first_waiting_fiber = nullptr;
+    }
+    counter->unlock();
+
+    // NOTE: The counter must not be accessed from this point on, as the resumed fibers might destroy it.
+    while (waiting_fiber)
+    {
+        Detail::JobFiber* next_waiting_fiber = waiting_fiber->next;
+        push_ready_fiber(waiting_fiber);
+        waiting_fiber = next_waiting_fiber;
+    }
+}
+
+Detail::Job* JobSystem::allocate_job()
+{
+    CAVE_ASSERT(s_job_system);
+    // NOTE: The job is constructed in place by the caller, so the pool running out of memory is unrecoverable.
+    Detail::Job* job = s_job_system->job_pool.allocate();
+    CAVE_VERIFY(job != nullptr);
+    return job;
+}
+
+void JobSystem::submit_job(Detail::Job* job, JobCounter* counter)
+{
+    job->counter = counter;
+    if (counter)
+        counter->m_value.fetch_add(1, std::memory_order_relaxed);
+
+    s_job_system->queued_job_count.fetch_add(1, std::memory_order_seq_cst);
+
+    const u32 thread_index = load_current_thread_index();
+    if (thread_index == invalid_thread_index || !s_job_system->threads[thread_index].deque.push(job))
+    {
+        std::scoped_lock lock(s_job_system->shared_queue_mutex);
+        s_job_system->shared_queue.add(job);
+    }
+
+    wake_sleeping_worker();
+}
+
+} // namespace CaveGame
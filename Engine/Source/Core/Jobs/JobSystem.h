@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+#include <atomic>
+#include <new>
+
+namespace CaveGame
+{
+
+using JobFunction = void (*)(void* user_data);
+
+namespace Detail
+{
+
+struct JobFiber;
+
+} // namespace Detail
+
+//
+// Counts the jobs that have been scheduled against it but haven't finished executing yet.
+//
+// A job (the parent) that schedules other jobs (its children) against a counter can wait for all of them to finish
+// by calling `JobSystem::wait_for_counter`, which expresses the dependency between the parent and its children.
+// The counter must outlive all the jobs scheduled against it, which is usually ensured by waiting for it.
+//
+// The fibers of the jobs waiting for the counter are stored in an intrusive list. The list is protected by a spin lock,
+// which is only taken by the waiting jobs and by the decrement that brings the counter to zero.
+//
+class JobCounter
+{
+    CAVE_MAKE_NONCOPYABLE(JobCounter);
+    CAVE_MAKE_NONMOVABLE(JobCounter);
+
+    friend class JobSystem;
+
+public:
+    JobCounter() = default;
+
+    // Returns the number of jobs that haven't finished executing yet.
+    NODISCARD ALWAYS_INLINE u32 value() const { return m_value.load(std::memory_order_acquire); }
+
+    // Returns whether or not all jobs scheduled against the counter have finished executing.
+    NODISCARD ALWAYS_INLINE bool is_zero() const { return (value() == 0); }
+
+private:
+    ALWAYS_INLINE void lock() const
+    {
+        while (m_is_locked.exchange(true, std::memory_order_acquire))
+        {
+            while (m_is_locked.load(std::memory_order_relaxed))
+                ;
+        }
+    }
+
+    ALWAYS_INLINE void unlock() const { m_is_locked.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<u32> m_value { 0 };
+    mutable std::atomic<bool> m_is_locked { false };
+    mutable Detail::JobFiber* m_first_waiting_fiber { nullptr };
+};
+
+namespace Detail
+{
+
+//
+// The unit of work executed by the job system. The job function and its data are stored inline, so a job fits in
+// a single cache line and scheduling a job never allocates memory from the heap.
+//
+struct Job
+{
+    static constexpr usize data_byte_count = 48;
+    static constexpr usize data_alignment = 16;
+
+    // Invoked with the address of the data. Responsible for destroying the data after the job has been executed.
+    JobFunction function;
+    JobCounter* counter;
+    alignas(data_alignment) u8 data[data_byte_count];
+};
+
+} // namespace Detail
+
+//
+// Executes jobs on a pool of worker threads, one for each processor core (the main thread counts as one of them).
+//
+// Each thread owns a work-stealing deque: the jobs scheduled by a thread are pushed to its own deque and, when a thread
+// runs out of jobs, it steals jobs from the deques of the other threads. The idle workers sleep until new jobs are
+// scheduled. Waiting for a counter never blocks the waiting thread, as it executes other jobs in the meantime.
+//
+// The worker threads execute the jobs on fibers (unless `CAVE_ENABLE_JOB_FIBERS` is set to 0). A job that waits for
+// a counter on a worker thread is parked: its fiber is suspended and the thread switches to another fiber, which keeps
+// executing jobs. The parked fiber is resumed by whichever worker thread next becomes free after the counter reaches
+// zero, so long dependency chains never leave a worker thread stalled with a half-finished job on its stack.
+//
+// NOTE: Jobs can be scheduled from any thread, but the threads that are not owned by the job system push their jobs
+// to a shared (locked) queue, so they should only schedule jobs occasionally.
+//
+class JobSystem
+{
+public:
+    // The value returned by `get_current_thread_index` for the threads that are not owned by the job system.
+    static constexpr u32 invalid_thread_index = static_cast<u32>(-1);
+
+public:
+    //
+    // Starts the worker threads. When the worker thread count is zero, one worker thread is started for each
+    // processor core except the one used by the main thread. Must be called from the main thread.
+    // Returns false if the job system has already been initialized.
+    //
+    static bool initialize(u32 worker_thread_count = 0);
+
+    // Executes all the jobs that are still scheduled and stops the worker threads. Must be called from the main thread.
+    static void shutdown();
+
+public:
+    // Returns the number of threads that execute jobs, including the main thread.
+    NODISCARD static u32 get_thread_count();
+
+    //
+    // Returns the index of the calling thread, which is zero for the main thread and between one and the thread count
+    // for the worker threads. Returns `invalid_thread_index` if the thread is not owned by the job system.
+    //
+    NODISCARD static u32 get_current_thread_index();
+
+public:
+    //
+    // Schedules a job that invokes the given function. If a counter is provided, it is incremented now and decremented
+    // after the job has been executed.
+    //
+    static void schedule(JobFunction function, void* user_data, JobCounter* counter = nullptr);
+
+    //
+    // Schedules a job that invokes the given callable (usually a lambda). The callable is moved into the job, so its
+    // captures must fit in `Detail::Job::data_byte_count` bytes. Capture large data by reference or pointer instead.
+    //
+    template<typename Callable>
+    static void schedule(Callable&& callable, JobCounter* counter = nullptr)
+    {
+        using CallableType = RemoveConst<RemoveReference<Callable>>;
+        static_assert(sizeof(CallableType) <= Detail::Job::data_byte_count, "The job captures too much data!");
+        static_assert(alignof(CallableType) <= Detail::Job::data_alignment, "The job captures over-aligned data!");
+
+        Detail::Job* job = allocate_job();
+        ::new (job->data) CallableType(forward<Callable>(callable));
+        job->function = [](void* data)
+        {
+            CallableType* job_callable = static_cast<CallableType*>(data);
+            (*job_callable)();
+            job_callable->~CallableType();
+        };
+
+        submit_job(job, counter);
+    }
+
+    //
+    // Blocks until all the jobs scheduled against the counter have finished executing. While waiting, the calling
+    // thread executes other scheduled jobs (which may include the jobs being waited for).
+    //
+    // NOTE: When called from a job executed by a worker thread, the job is parked and might be resumed on a different
+    // worker thread. Thread-local state must not be cached across the call, nor any lock held while waiting.
+    //
+    static void wait_for_counter(const JobCounter& counter);
+
+private:
+    NODISCARD static Detail::Job* allocate_job();
+    static void submit_job(Detail::Job* job, JobCounter* counter);
+
+    // Executes the job, releases it and decrements the counter it has been scheduled against.
+    static void execute_job(Detail::Job* job);
+
+    // Decrements the counter and, if it reached zero, resumes the fibers waiting for it.
+    static void decrement_counter(JobCounter* counter);
+
+    //
+    // Performs the actions requested by the fiber that the calling thread has just switched away from. Must be called
+    // by every fiber right after it starts or resumes executing.
+    //
+    static void complete_fiber_switch();
+
+    static void worker_thread_main(u32 thread_index);
+    static void job_fiber_main(void* user_data);
+};
+
+} // namespace CaveGame
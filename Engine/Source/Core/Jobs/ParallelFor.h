@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/Vector.h>
+#include <Core/Jobs/JobSystem.h>
+
+namespace CaveGame
+{
+
+//
+// The grain size passed to the parallel algorithms to let them select it automatically.
+//
+// For `parallel_for`, the range is split into about `auto_grain_chunks_per_thread` chunks for each thread, which leaves
+// enough chunks for the threads that finish early to steal, without paying the scheduling cost for every few elements.
+// For `parallel_reduce`, the range is always split into (at most) `auto_grain_reduce_chunk_count` chunks, independently
+// of the number of threads, such that the result is the same on every machine.
+//
+static constexpr usize auto_grain_size = 0;
+static constexpr usize auto_grain_chunks_per_thread = 8;
+static constexpr usize auto_grain_reduce_chunk_count = 256;
+
+namespace Detail
+{
+
+template<typename RangeFunction>
+struct ParallelForContext
+{
+    RangeFunction* range_function;
+    usize grain_size;
+    JobCounter counter;
+};
+
+//
+// Executes the range function over [begin, end). While the range is larger than the grain size, its upper half is
+// scheduled as a separate job and the lower half is processed further by the calling thread. The idle threads thus
+// steal the largest pending halves first, which balances the work with a logarithmic number of steals.
+//
+template<typename RangeFunction>
+void parallel_for_range(ParallelForContext<RangeFunction>* context, usize begin, usize end)
+{
+    while (end - begin > context->grain_size)
+    {
+        const usize middle = begin + (end - begin) / 2;
+        JobSystem::schedule([context, middle, end]() { parallel_for_range(context, middle, end); }, &context->counter);
+        end = middle;
+    }
+
+    (*context->range_function)(begin, end);
+}
+
+} // namespace Detail
+
+//
+// Invokes `range_function(chunk_begin, chunk_end)` for disjoint chunks that cover the index range [begin, end), on the
+// job system threads, and returns after all chunks have been processed. No chunk is larger than the grain size.
+// The chunks are processed in no particular order, so the function must not depend on the order of the indices.
+//
+// NOTE: This function waits for a job counter, so the same rules as for `JobSystem::wait_for_counter` apply when it
+// is called from a job.
+//
+template<typename RangeFunction>
+void parallel_for(usize begin, usize end, usize grain_size, RangeFunction&& range_function)
+{
+    CAVE_ASSERT(begin <= end);
+    const usize count = end - begin;
+    if (count == 0)
+        return;
+
+    if (grain_size == auto_grain_size)
+    {
+        const usize chunk_count = static_cast<usize>(JobSystem::get_thread_count()) * auto_grain_chunks_per_thread;
+        grain_size = (count + chunk_count - 1) / chunk_count;
+    }
+
+    // Avoid scheduling any job if the range can't be split.
+    if (count <= grain_size)
+    {
+        range_function(begin, end);
+        return;
+    }
+
+    using RangeFunctionType = RemoveReference<RangeFunction>;
+    Detail::ParallelForContext<RangeFunctionType> context = { &range_function, grain_size, {} };
+    Detail::parallel_for_range(&context, begin, end);
+    JobSystem::wait_for_counter(context.counter);
+}
+
+//
+// Invokes `element_function(element)` for each element of the vector, on the job system threads.
+// The vector must not be resized until the function returns.
+//
+template<typename T, typename AllocatorType, typename ElementFunction>
+void parallel_for(Vector<T, AllocatorType>& vector, usize grain_size, ElementFunction&& element_function)
+{
+    T* elements = vector.elements();
+    parallel_for(
+        0,
+        vector.count(),
+        grain_size,
+        [elements, &element_function](usize begin, usize end)
+        {
+            for (usize index = begin; index < end; ++index)
+                element_function(elements[index]);
+        }
+    );
+}
+
+template<typename T, typename AllocatorType, typename ElementFunction>
+void parallel_for(const Vector<T, AllocatorType>& vector, usize grain_size, ElementFunction&& element_function)
+{
+    const T* elements = vector.elements();
+    parallel_for(
+        0,
+        vector.count(),
+        grain_size,
+        [elements, &element_function](usize begin, usize end)
+        {
+            for (usize index = begin; index < end; ++index)
+                element_function(elements[index]);
+        }
+    );
+}
+
+//
+// Reduces the index range [begin, end) to a single value, on the job system threads.
+//
+// The range is split into chunks of exactly `grain_size` indices (except for the last one), `reduce_function(chunk_begin,
+// chunk_end)` computes the partial result of each chunk in parallel and the partial results are combined from left to
+// right, starting with the identity, using `combine_function(accumulated, partial)`. The split points and the order
+// of the combinations only depend on the range and the grain size, so the result is bit-identical across runs (and
+// thread counts), even for non-associative operations such as floating point additions.
+//
+template<typename ResultType, typename ReduceFunction, typename CombineFunction>
+NODISCARD ResultType parallel_reduce(
+    usize begin,
+    usize end,
+    usize grain_size,
+    const ResultType& identity,
+    ReduceFunction&& reduce_function,
+    CombineFunction&& combine_function
+)
+{
+    CAVE_ASSERT(begin <= end);
+    const usize count = end - begin;
+    if (count == 0)
+        return identity;
+
+    if (grain_size == auto_grain_size)
+        grain_size = (count + auto_grain_reduce_chunk_count - 1) / auto_grain_reduce_chunk_count;
+
+    const usize chunk_count = (count + grain_size - 1) / grain_size;
+    if (chunk_count == 1)
+        return combine_function(identity, reduce_function(begin, end));
+
+    Vector<ResultType> partial_results;
+    partial_results.set_count(chunk_count, identity);
+    ResultType* partial_result_elements = partial_results.elements();
+
+    // Each job processes whole chunks, so the partial results don't depend on how the chunks are distributed.
+    parallel_for(
+        0,
+        chunk_count,
+        1,
+        [&](usize chunk_begin, usize chunk_end)
+        {
+            for (usize chunk_index = chunk_begin; chunk_index < chunk_end; ++chunk_index)
+            {
+                const usize range_begin = begin + chunk_index * grain_size;
+                const usize range_end = (end - range_begin > grain_size) ? (range_begin + grain_size) : end;
+                partial_result_elements[chunk_index] = reduce_function(range_begin, range_end);
+            }
+        }
+    );
+
+    ResultType result = identity;
+    for (usize chunk_index = 0; chunk_index < chunk_count; ++chunk_index)
+        result = combine_function(result, partial_result_elements[chunk_index]);
+    return result;
+}
+
+//
+// Reduces the elements of the vector to a single value, on the job system threads. Each element is first transformed
+// by `map_function(element)` and the values are then combined using `combine_function(accumulated, value)`.
+// The result is bit-identical across runs, as described for the index range version above.
+//
+template<typename ResultType, typename T, typename AllocatorType, typename MapFunction, typename CombineFunction>
+NODISCARD ResultType parallel_reduce(
+    const Vector<T, AllocatorType>& vector,
+    usize grain_size,
+    const ResultType& identity,
+    MapFunction&& map_function,
+    CombineFunction&& combine_function
+)
+{
+    const T* elements = vector.elements();
+    return parallel_reduce(
+        0,
+        vector.count(),
+        grain_size,
+        identity,
+        [&](usize begin, usize end) -> ResultType
+        {
+            ResultType result = identity;
+            for (usize index = begin; index < end; ++index)
+                result = combine_function(result, map_function(elements[index]));
+            return result;
+        },
+        combine_function
+    );
+}
+
+} // namespace CaveGame
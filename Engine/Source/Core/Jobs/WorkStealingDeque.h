@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+#include <atomic>
+
+namespace CaveGame
+{
+
+//
+// Bounded work-stealing deque, as described by Chase and Lev ("Dynamic Circular Work-Stealing Deque"), using the
+// memory orderings proven correct by Le et al. ("Correct and Efficient Work-Stealing for Weak Memory Models").
+//
+// The owner thread pushes and pops elements at the bottom of the deque (in LIFO order, which keeps the data of
+// recently scheduled work hot in its cache), while any other thread can steal elements from the top. The owner only
+// synchronizes with the thieves when the deque holds a single element.
+//
+// The stored type must be a pointer. The capacity must be a power of two.
+//
+template<typename T, u32 Capacity>
+class WorkStealingDeque
+{
+    static_assert(std::is_pointer_v<T>, "The work-stealing deque can only store pointers!");
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "The capacity must be a power of two!");
+
+    CAVE_MAKE_NONCOPYABLE(WorkStealingDeque);
+    CAVE_MAKE_NONMOVABLE(WorkStealingDeque);
+
+public:
+    WorkStealingDeque() = default;
+
+public:
+    //
+    // Pushes an element at the bottom of the deque. Returns false if the deque is full.
+    // Can only be called by the owner thread.
+    //
+    NODISCARD bool push(T element)
+    {
+        const i64 bottom = m_bottom.load(std::memory_order_relaxed);
+        const i64 top = m_top.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<i64>(Capacity))
+            return false;
+
+        m_elements[bottom & index_mask].store(element, std::memory_order_relaxed);
+        // Publish the element (and the data it points to) to the thieves.
+        m_bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    //
+    // Pops the element at the bottom of the deque (the most recently pushed one). Returns nullptr if the deque is empty.
+    // Can only be called by the owner thread.
+    //
+    NODISCARD T pop()
+    {
+        const i64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        // The reservation of the bottom element must be visible to the thieves before the top is read.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        i64 top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            // The deque is empty. Restore the bottom index.
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T element = m_elements[bottom & index_mask].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // This is the last element, so the thieves might try to steal it as well. Race them by advancing the top.
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                element = nullptr;
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return element;
+    }
+
+    //
+    // Steals the element at the top of the deque (the least recently pushed one). Returns nullptr if the deque is
+    // empty or if another thread has won the race for the element. Can be called by any thread.
+    //
+    NODISCARD T steal()
+    {
+        i64 top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const i64 bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+            return nullptr;
+
+        T element = m_elements[top & index_mask].load(std::memory_order_relaxed);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+
+        return element;
+    }
+
+    // Returns the approximate number of elements stored in the deque.
+    NODISCARD ALWAYS_INLINE usize approximate_count() const
+    {
+        const i64 count = m_bottom.load(std::memory_order_relaxed) - m_top.load(std::memory_order_relaxed);
+        return (count > 0) ? static_cast<usize>(count) : 0;
+    }
+
+private:
+    static constexpr i64 index_mask = static_cast<i64>(Capacity) - 1;
+
+    // NOTE: The indices are placed on separate cache lines, as the top is written by the thieves while the bottom
+    // is written by the owner.
+    alignas(64) std::atomic<i64> m_top { 0 };
+    alignas(64) std::atomic<i64> m_bottom { 0 };
+    alignas(64) std::atomic<T> m_elements[Capacity] {};
+};
+
+} // namespace CaveGame
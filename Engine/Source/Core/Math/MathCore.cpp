@@ -14,17 +14,17 @@ namespace CaveGame
 
 float Math::sqrt(float value)
 {
-    return std::sqrtf(value);
+    return std::sqrt(value);
 }
 
 float Math::sin(float value)
 {
-    return std::sinf(value);
+    return std::sin(value);
 }
 
 float Math::cos(float value)
 {
-    return std::cosf(value);
+    return std::cos(value);
 }
 
 float Math::tan(float value)
@@ -37,23 +37,23 @@ void Math::sin_and_cos(float value, float& out_sin, float& out_cos)
     // NOTE: Computing both the sine and the cosine of the angle in a single call might provide
     // better performance, as the compiler is able to recognize this pattern and *maybe* optimize it.
 
-    out_sin = std::sinf(value);
-    out_cos = std::cosf(value);
+    out_sin = std::sin(value);
+    out_cos = std::cos(value);
 }
 
 float Math::asin(float value)
 {
-    return std::asinf(value);
+    return std::asin(value);
 }
 
 float Math::acos(float value)
 {
-    return std::acosf(value);
+    return std::acos(value);
 }
 
 float Math::atan(float value)
 {
-    return std::atanf(value);
+    return std::atan(value);
 }
 
 } // namespace CaveGame
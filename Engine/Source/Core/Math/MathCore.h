@@ -8,8 +8,13 @@
 
 #pragma once
 
+#include <Core/Assertion.h>
 #include <Core/CoreTypes.h>
 
+#if CAVE_COMPILER_MSVC
+    #include <intrin.h>
+#endif // CAVE_COMPILER_MSVC
+
 namespace CaveGame
 {
 
@@ -75,6 +80,57 @@ public:
         return (value < T(0)) ? -value : value;
     }
 
+public:
+    //
+    // Bit manipulation functions.
+    //
+
+    // Returns the number of trailing zero bits in the given value. The value must not be zero.
+    NODISCARD ALWAYS_INLINE static u32 count_trailing_zeros(u32 value)
+    {
+        CAVE_ASSERT(value != 0);
+#if CAVE_COMPILER_MSVC
+        unsigned long bit_index;
+        _BitScanForward(&bit_index, value);
+        return static_cast<u32>(bit_index);
+#else
+        return static_cast<u32>(__builtin_ctz(value));
+#endif // CAVE_COMPILER_MSVC
+    }
+
+    // Returns the number of trailing zero bits in the given value. The value must not be zero.
+    NODISCARD ALWAYS_INLINE static u32 count_trailing_zeros(u64 value)
+    {
+        CAVE_ASSERT(value != 0);
+#if CAVE_COMPILER_MSVC
+        unsigned long bit_index;
+        _BitScanForward64(&bit_index, value);
+        return static_cast<u32>(bit_index);
+#else
+        return static_cast<u32>(__builtin_ctzll(value));
+#endif // CAVE_COMPILER_MSVC
+    }
+
+    // Returns the number of leading zero bits in the given value. The value must not be zero.
+    NODISCARD ALWAYS_INLINE static u32 count_leading_zeros(u64 value)
+    {
+        CAVE_ASSERT(value != 0);
+#if CAVE_COMPILER_MSVC
+        unsigned long bit_index;
+        _BitScanReverse64(&bit_index, value);
+        return 63 - static_cast<u32>(bit_index);
+#else
+        return static_cast<u32>(__builtin_clzll(value));
+#endif // CAVE_COMPILER_MSVC
+    }
+
+    // Rounds the value up to the next multiple of the given alignment, which must be a power of two.
+    NODISCARD ALWAYS_INLINE static usize align_up(usize value, usize alignment)
+    {
+        CAVE_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
 public:
     //
     // Real-numbers elementary functions.
@@ -36,9 +36,7 @@ public:
         : rows { Vector3(0), Vector3(0), Vector3(0) }
     {}
 
-    ALWAYS_INLINE Matrix3(const Matrix3& other)
-        : rows { other.rows[0], other.rows[1], other.rows[2] }
-    {}
+    Matrix3(const Matrix3& other) = default;
 
     ALWAYS_INLINE Matrix3(Vector3 row0, Vector3 row1, Vector3 row2)
         : rows { row0, row1, row2 }
@@ -78,9 +76,7 @@ public:
         : rows { Vector4(0), Vector4(0), Vector4(0), Vector4(0) }
     {}
 
-    ALWAYS_INLINE Matrix4(const Matrix4& other)
-        : rows { other.rows[0], other.rows[1], other.rows[2], other.rows[3] }
-    {}
+    Matrix4(const Matrix4& other) = default;
 
     ALWAYS_INLINE Matrix4(Vector4 row0, Vector4 row1, Vector4 row2, Vector4 row3)
         : rows { row0, row1, row2, row3 }
@@ -54,10 +54,7 @@ public:
         , y(0.0F)
     {}
 
-    ALWAYS_INLINE Vector2(const Vector2& other)
-        : x(other.x)
-        , y(other.y)
-    {}
+    Vector2(const Vector2& other) = default;
 
     ALWAYS_INLINE Vector2(float in_x, float in_y)
         : x(in_x)
@@ -232,11 +229,7 @@ public:
         , z(0.0F)
     {}
 
-    ALWAYS_INLINE Vector3(const Vector3& other)
-        : x(other.x)
-        , y(other.y)
-        , z(other.z)
-    {}
+    Vector3(const Vector3& other) = default;
 
     ALWAYS_INLINE Vector3(float in_x, float in_y, float in_z)
         : x(in_x)
@@ -377,12 +370,7 @@ public:
         , w(0.0F)
     {}
 
-    ALWAYS_INLINE Vector4(const Vector4& other)
-        : x(other.x)
-        , y(other.y)
-        , z(other.z)
-        , w(other.w)
-    {}
+    Vector4(const Vector4& other) = default;
 
     ALWAYS_INLINE Vector4(float in_x, float in_y, float in_z, float in_w)
         : x(in_x)
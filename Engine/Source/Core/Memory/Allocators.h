@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+#include <Core/Memory/FrameAllocator.h>
+#include <Core/Memory/LinearAllocator.h>
+#include <new>
+
+namespace CaveGame
+{
+
+//
+// Allocators used as template parameters by the containers (for example, `Vector<T, AllocatorType>`).
+// Every allocator must implement the following functions:
+//
+//   void* allocate(usize byte_count, usize alignment);
+//       Allocates a memory block of the given size and alignment. Never returns nullptr for a valid request.
+//
+//   void release(void* memory_block, usize byte_count, usize alignment);
+//       Releases a memory block previously returned by `allocate`. The size and alignment are the values used
+//       when the block was allocated (sized deallocation). Releasing a nullptr block is a no-op.
+//
+//   bool try_expand_in_place(void* memory_block, usize old_byte_count, usize new_byte_count);
+//       Tries to grow the memory block without moving it. Returns false if that isn't possible, in which
+//       case the block is left untouched.
+//
+
+//
+// Allocator that serves the memory blocks from the global heap, using the global `new` and `delete` operators.
+//
+class HeapAllocator
+{
+public:
+    NODISCARD ALWAYS_INLINE void* allocate(usize byte_count, usize alignment)
+    {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(byte_count, static_cast<std::align_val_t>(alignment));
+        return ::operator new(byte_count);
+    }
+
+    ALWAYS_INLINE void release(void* memory_block, usize byte_count, usize alignment)
+    {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            ::operator delete(memory_block, byte_count, static_cast<std::align_val_t>(alignment));
+        else
+            ::operator delete(memory_block, byte_count);
+    }
+
+    // The global heap provides no portable way of growing a memory block in place.
+    NODISCARD ALWAYS_INLINE bool try_expand_in_place(void*, usize, usize) { return false; }
+
+    NODISCARD ALWAYS_INLINE bool operator==(const HeapAllocator&) const { return true; }
+};
+
+//
+// Allocator that serves the memory blocks from a linear allocator. The memory blocks are never released
+// individually, but the last block allocated can be grown in place.
+// The referenced linear allocator must outlive all the memory blocks allocated through this allocator.
+//
+class LinearAllocatorProxy
+{
+public:
+    ALWAYS_INLINE LinearAllocatorProxy()
+        : m_linear_allocator(nullptr)
+    {}
+
+    ALWAYS_INLINE LinearAllocatorProxy(LinearAllocator& linear_allocator)
+        : m_linear_allocator(&linear_allocator)
+    {}
+
+    NODISCARD ALWAYS_INLINE void* allocate(usize byte_count, usize alignment)
+    {
+        CAVE_ASSERT(m_linear_allocator);
+        return m_linear_allocator->allocate(byte_count, alignment);
+    }
+
+    ALWAYS_INLINE void release(void*, usize, usize) {}
+
+    NODISCARD ALWAYS_INLINE bool try_expand_in_place(void* memory_block, usize old_byte_count, usize new_byte_count)
+    {
+        CAVE_ASSERT(m_linear_allocator);
+        return m_linear_allocator->try_expand_in_place(memory_block, old_byte_count, new_byte_count);
+    }
+
+    NODISCARD ALWAYS_INLINE bool operator==(const LinearAllocatorProxy& other) const { return (m_linear_allocator == other.m_linear_allocator); }
+
+private:
+    LinearAllocator* m_linear_allocator;
+};
+
+//
+// Allocator that serves the memory blocks from the frame allocator. The memory blocks are released automatically
+// two frames after they were allocated, so containers using this allocator must not outlive the next frame.
+//
+class FrameAllocatorProxy
+{
+public:
+    NODISCARD ALWAYS_INLINE void* allocate(usize byte_count, usize alignment) { return FrameAllocator::allocate(byte_count, alignment); }
+
+    ALWAYS_INLINE void release(void*, usize, usize) {}
+
+    NODISCARD ALWAYS_INLINE bool try_expand_in_place(void* memory_block, usize old_byte_count, usize new_byte_count)
+    {
+        return FrameAllocator::get_current_frame_allocator().try_expand_in_place(memory_block, old_byte_count, new_byte_count);
+    }
+
+    NODISCARD ALWAYS_INLINE bool operator==(const FrameAllocatorProxy&) const { return true; }
+};
+
+} // namespace CaveGame
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Memory/FrameAllocator.h>
+
+namespace CaveGame
+{
+
+struct FrameAllocatorData
+{
+    LinearAllocator frame_allocators[2];
+    u32 current_frame_index { 0 };
+};
+
+static FrameAllocatorData* s_frame_allocator;
+
+bool FrameAllocator::initialize(usize reserved_byte_count_per_frame)
+{
+    if (s_frame_allocator)
+    {
+        // The frame allocator has already been initialized.
+        return false;
+    }
+
+    s_frame_allocator = new FrameAllocatorData();
+    for (LinearAllocator& frame_allocator : s_frame_allocator->frame_allocators)
+    {
+        if (!frame_allocator.initialize(reserved_byte_count_per_frame))
+        {
+            // Don't leave the frame allocator half-initialized. Destroying the data shuts down the frame allocators
+            // that have already been initialized, which releases their reserved address space.
+            delete s_frame_allocator;
+            s_frame_allocator = nullptr;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FrameAllocator::shutdown()
+{
+    if (!s_frame_allocator)
+    {
+        // The frame allocator has already been shut down.
+        return;
+    }
+
+    delete s_frame_allocator;
+    s_frame_allocator = nullptr;
+}
+
+void FrameAllocator::begin_frame()
+{
+    CAVE_ASSERT(s_frame_allocator);
+
+    // The buffer that becomes current was used two frames ago, so its allocations are no longer referenced.
+    s_frame_allocator->current_frame_index ^= 1;
+    get_current_frame_allocator().reset();
+}
+
+void* FrameAllocator::allocate(usize byte_count, usize alignment)
+{
+    return get_current_frame_allocator().allocate(byte_count, alignment);
+}
+
+LinearAllocator& FrameAllocator::get_current_frame_allocator()
+{
+    CAVE_ASSERT(s_frame_allocator);
+    return s_frame_allocator->frame_allocators[s_frame_allocator->current_frame_index];
+}
+
+} // namespace CaveGame
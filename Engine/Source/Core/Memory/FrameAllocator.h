@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Memory/LinearAllocator.h>
+#include <new>
+
+namespace CaveGame
+{
+
+//
+// Scratch allocator for memory that only needs to live for the duration of a frame, such as visibility lists or
+// mesh build buffers. Allocating is a pointer bump and releasing is free, as all allocations are released at once.
+//
+// The allocator is double-buffered: the allocations made during a frame remain valid during the next frame as well,
+// and are only released when `begin_frame` is invoked for the second time. This allows the results computed in one
+// frame to be consumed by the next one, without copying them.
+//
+// NOTE: The destructors of the objects created using the frame allocator are never invoked. Only types that
+// don't require destruction (or whose destruction can be skipped) should be created using it.
+// NOTE: The frame allocator is not thread-safe and should only be used from the main thread.
+//
+class FrameAllocator
+{
+public:
+    // The size of the virtual range reserved for each of the two frame buffers.
+    static constexpr usize default_reserved_byte_count_per_frame = 256 * MiB;
+
+public:
+    static bool initialize(usize reserved_byte_count_per_frame = default_reserved_byte_count_per_frame);
+    static void shutdown();
+
+    //
+    // Advances the allocator to the next frame. The allocations made during the previous-to-last frame are released.
+    // Invoked by the engine at the start of each frame.
+    //
+    static void begin_frame();
+
+public:
+    // Allocates a memory block of the given size and alignment from the current frame buffer.
+    NODISCARD static void* allocate(usize byte_count, usize alignment = LinearAllocator::default_alignment);
+
+    // Returns the linear allocator that backs the current frame.
+    NODISCARD static LinearAllocator& get_current_frame_allocator();
+
+    // Allocates (uninitialized) memory for an array of `count` elements of type `T`.
+    template<typename T>
+    NODISCARD ALWAYS_INLINE static T* allocate_array(usize count)
+    {
+        void* memory_block = allocate(count * sizeof(T), alignof(T));
+        return static_cast<T*>(memory_block);
+    }
+
+    //
+    // Creates an instance of type `T` in the current frame buffer, by forwarding the provided parameters to its constructor.
+    // The destructor of the instance will never be invoked.
+    //
+    template<typename T, typename... Args>
+    NODISCARD ALWAYS_INLINE static T* create(Args&&... args)
+    {
+        void* memory_block = allocate(sizeof(T), alignof(T));
+        return new (memory_block) T(forward<Args>(args)...);
+    }
+};
+
+} // namespace CaveGame
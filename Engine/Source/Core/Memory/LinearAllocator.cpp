@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Math/MathCore.h>
+#include <Core/Memory/LinearAllocator.h>
+
+namespace CaveGame
+{
+
+//
+// The pages are committed in blocks of (at least) this size, in order to reduce the number of system calls
+// made while the allocator warms up.
+//
+static constexpr usize linear_allocator_commit_granularity = 64 * KiB;
+
+LinearAllocator::~LinearAllocator()
+{
+    shutdown();
+}
+
+bool LinearAllocator::initialize(usize reserved_byte_count)
+{
+    if (m_arena.is_initialized())
+    {
+        // The allocator has already been initialized.
+        return false;
+    }
+
+    if (!m_arena.initialize(reserved_byte_count, linear_allocator_commit_granularity))
+        return false;
+
+    m_offset = 0;
+    return true;
+}
+
+void LinearAllocator::shutdown()
+{
+    if (!m_arena.is_initialized())
+    {
+        // The allocator has already been shut down.
+        return;
+    }
+
+    m_arena.shutdown();
+    m_offset = 0;
+}
+
+void* LinearAllocator::allocate(usize byte_count, usize alignment)
+{
+    // The alignment must be a power of two.
+    CAVE_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    const usize aligned_offset = Math::align_up(m_offset, alignment);
+    const usize new_offset = aligned_offset + byte_count;
+
+    if (!m_arena.ensure_committed(new_offset))
+    {
+        // The reserved range of the allocator has been exhausted.
+        CAVE_ASSERT(false);
+        return nullptr;
+    }
+
+    m_offset = new_offset;
+    return m_arena.base_address() + aligned_offset;
+}
+
+bool LinearAllocator::try_expand_in_place(void* memory_block, usize old_byte_count, usize new_byte_count)
+{
+    u8* block_address = static_cast<u8*>(memory_block);
+    if (!owns(block_address) || block_address + old_byte_count != m_arena.base_address() + m_offset)
+    {
+        // The memory block is not the last allocation made.
+        return false;
+    }
+
+    const usize new_offset = m_offset - old_byte_count + new_byte_count;
+    if (!m_arena.ensure_committed(new_offset))
+        return false;
+
+    m_offset = new_offset;
+    return true;
+}
+
+} // namespace CaveGame
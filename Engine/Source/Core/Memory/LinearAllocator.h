@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+#include <Core/Memory/VirtualArena.h>
+
+namespace CaveGame
+{
+
+//
+// Allocator that serves allocations by bumping an offset inside a reserved range of virtual memory.
+// Individual allocations can't be released. Instead, all allocations are released at once by resetting the allocator.
+//
+// The allocator is backed by a virtual arena: the range is reserved up-front, but the pages are only committed when the
+// offset first reaches them, so the physical memory usage matches the high-water mark of the allocator. As the range
+// never moves, the pointers returned by the allocator remain stable until the allocator is reset.
+//
+class LinearAllocator
+{
+    CAVE_MAKE_NONCOPYABLE(LinearAllocator);
+    CAVE_MAKE_NONMOVABLE(LinearAllocator);
+
+public:
+    static constexpr usize default_alignment = 16;
+
+public:
+    LinearAllocator() = default;
+    ~LinearAllocator();
+
+    //
+    // Reserves the virtual memory range used by the allocator.
+    // Returns false if the range couldn't be reserved.
+    //
+    bool initialize(usize reserved_byte_count);
+
+    //
+    // Releases the virtual memory range used by the allocator. All pointers returned by the allocator are invalidated.
+    //
+    void shutdown();
+
+public:
+    //
+    // Allocates a memory block of the given size and alignment. The alignment must be a power of two.
+    // Returns nullptr (and triggers an assert) if the reserved range has been exhausted.
+    //
+    NODISCARD void* allocate(usize byte_count, usize alignment = default_alignment);
+
+    //
+    // Tries to grow the given memory block in place. This is only possible if the block is the last allocation made,
+    // in which case the offset is simply advanced. Returns false if the block can't be grown in place.
+    //
+    NODISCARD bool try_expand_in_place(void* memory_block, usize old_byte_count, usize new_byte_count);
+
+    //
+    // Releases all allocations made by the allocator. The committed pages are kept, so that
+    // future allocations don't have to commit them again.
+    //
+    ALWAYS_INLINE void reset() { m_offset = 0; }
+
+    //
+    // Returns the committed pages that are not used by any allocation to the operating system. Useful after a spike
+    // in memory usage, as the committed pages are otherwise kept until the allocator is shut down.
+    //
+    ALWAYS_INLINE void decommit_unused_pages() { m_arena.decommit_after(m_offset); }
+
+    // Returns whether or not the given address has been allocated from (is located inside) the allocator's range.
+    NODISCARD ALWAYS_INLINE bool owns(const void* address) const { return m_arena.owns(address); }
+
+public:
+    NODISCARD ALWAYS_INLINE usize used_byte_count() const { return m_offset; }
+    NODISCARD ALWAYS_INLINE usize committed_byte_count() const { return m_arena.committed_byte_count(); }
+    NODISCARD ALWAYS_INLINE usize reserved_byte_count() const { return m_arena.reserved_byte_count(); }
+
+private:
+    VirtualArena m_arena;
+    usize m_offset { 0 };
+};
+
+} // namespace CaveGame
@@ -20,6 +20,14 @@ namespace CaveGame
 //
 void copy_memory(void* destination, const void* source, usize byte_count);
 
+//
+// Copies the provided number of bytes from the `source` buffer to the `destination` buffer. Unlike `copy_memory`,
+// the two buffers are allowed to overlap, in which case the copy is performed as if an intermediate buffer was used.
+// Both the destination and source buffer must be at least large enough to contain `byte_count` bytes, otherwise
+// a buffer overrun may occur. This function performs no such checks, so it is up to the caller to ensure it.
+//
+void move_memory(void* destination, const void* source, usize byte_count);
+
 //
 // Copies the provided number of bytes from the `destination` buffer to the `source` buffer, in reverse order.
 // Both the destination and source buffer must be at least large enough to contain `byte_count` bytes, otherwise
@@ -41,4 +49,17 @@ void set_memory(void* destination, u8 byte_value, usize byte_count);
 //
 void zero_memory(void* destination, usize byte_count);
 
+//
+// Lexicographically compares the first `byte_count` bytes of the two buffers, interpreted as unsigned bytes.
+// Returns zero if the buffers are equal, a negative value if the first differing byte is smaller in the `lhs`
+// buffer and a positive value otherwise. The comparison stops at the first differing byte.
+//
+NODISCARD i32 compare_memory(const void* lhs, const void* rhs, usize byte_count);
+
+//
+// Returns whether or not the first `byte_count` bytes of the two buffers are equal.
+// The comparison stops at the first differing byte.
+//
+NODISCARD bool memory_equals(const void* lhs, const void* rhs, usize byte_count);
+
 } // namespace CaveGame
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Math/MathCore.h>
+#include <Core/Memory/PoolAllocator.h>
+#include <Core/Platform/PlatformCore.h>
+
+namespace CaveGame
+{
+
+// The number of blocks moved between a magazine and the shared free list at once.
+static constexpr u32 magazine_batch_count = FixedSizePoolAllocator::magazine_capacity / 2;
+
+// The value returned by `get_thread_magazine_index` for the threads that don't have a magazine.
+static constexpr u32 invalid_magazine_index = static_cast<u32>(-1);
+
+// NOTE: The regions are over-reserved by one slab, so that their slabs can be aligned to the slab size.
+static constexpr usize region_reserved_byte_count = (FixedSizePoolAllocator::slabs_per_region + 1) * FixedSizePoolAllocator::slab_byte_count;
+
+//======================================================================================
+// THREAD MAGAZINE INDICES.
+//======================================================================================
+//
+// Each thread that uses the pools is assigned a magazine index, which selects the magazine used by the thread in every
+// pool. When the thread exits, the free blocks left in its magazines are flushed to the shared free list of each pool
+// and only then the index is returned, so it can be reused by another thread.
+//
+
+class MagazineIndexRegistry
+{
+public:
+    NODISCARD u32 acquire_index()
+    {
+        std::scoped_lock lock(m_mutex);
+        for (u32 index = 0; index < FixedSizePoolAllocator::max_thread_count; ++index)
+        {
+            if (!m_is_index_used[index])
+            {
+                m_is_index_used[index] = true;
+                return index;
+            }
+        }
+        return invalid_magazine_index;
+    }
+
+    void release_index(u32 index)
+    {
+        std::scoped_lock lock(m_mutex);
+        for (FixedSizePoolAllocator* pool = m_first_pool; pool; pool = pool->m_next_pool)
+            pool->flush_thread_magazine(index);
+        m_is_index_used[index] = false;
+    }
+
+    void register_pool(FixedSizePoolAllocator* pool)
+    {
+        std::scoped_lock lock(m_mutex);
+        pool->m_next_pool = m_first_pool;
+        if (m_first_pool)
+            m_first_pool->m_previous_pool = pool;
+        m_first_pool = pool;
+    }
+
+    void unregister_pool(FixedSizePoolAllocator* pool)
+    {
+        std::scoped_lock lock(m_mutex);
+        if (pool->m_previous_pool)
+            pool->m_previous_pool->m_next_pool = pool->m_next_pool;
+        else
+            m_first_pool = pool->m_next_pool;
+        if (pool->m_next_pool)
+            pool->m_next_pool->m_previous_pool = pool->m_previous_pool;
+    }
+
+private:
+    // NOTE: The registry lock is always acquired before the lock of any pool.
+    std::mutex m_mutex;
+    bool m_is_index_used[FixedSizePoolAllocator::max_thread_count] {};
+    FixedSizePoolAllocator* m_first_pool { nullptr };
+};
+
+static MagazineIndexRegistry& get_magazine_index_registry()
+{
+    // NOTE: The registry is never destroyed, as threads might exit during (or after) static destruction.
+    static MagazineIndexRegistry* s_registry = new MagazineIndexRegistry();
+    return *s_registry;
+}
+
+// The value of `s_thread_magazine_index` before the thread has used any pool.
+static constexpr u32 unassigned_magazine_index = static_cast<u32>(-2);
+
+//
+// The magazine index of the calling thread.
+// NOTE: The index is trivially destructible, so it remains accessible while the thread-local objects are destroyed.
+// After the index has been released, it is set to `invalid_magazine_index`, so the pools used by the destructors of
+// other thread-local objects fall back to their shared free lists instead of writing to a released magazine.
+//
+static thread_local u32 s_thread_magazine_index = unassigned_magazine_index;
+
+struct ThreadMagazineIndexReleaser
+{
+    ~ThreadMagazineIndexReleaser()
+    {
+        const u32 index = s_thread_magazine_index;
+        s_thread_magazine_index = invalid_magazine_index;
+        if (index != invalid_magazine_index)
+            get_magazine_index_registry().release_index(index);
+    }
+};
+
+NODISCARD static u32 get_thread_magazine_index()
+{
+    if (s_thread_magazine_index == unassigned_magazine_index)
+    {
+        s_thread_magazine_index = get_magazine_index_registry().acquire_index();
+        // Constructed only once per thread, which registers the release of the index when the thread exits.
+        static thread_local ThreadMagazineIndexReleaser s_thread_magazine_index_releaser;
+    }
+    return s_thread_magazine_index;
+}
+
+//======================================================================================
+// FIXED SIZE POOL ALLOCATOR.
+//======================================================================================
+
+FixedSizePoolAllocator::FixedSizePoolAllocator(usize block_byte_count, usize block_alignment)
+{
+    CAVE_ASSERT(block_alignment > 0 && (block_alignment & (block_alignment - 1)) == 0);
+
+    // Free blocks store the address of the next free block, so they must be able to hold a pointer.
+    m_block_alignment = Math::max(block_alignment, alignof(FreeBlock));
+    m_block_byte_count = Math::align_up(Math::max(block_byte_count, sizeof(FreeBlock)), m_block_alignment);
+    m_first_block_offset = Math::align_up(sizeof(SlabHeader), m_block_alignment);
+
+    // NOTE: Larger blocks would waste too much of each slab. Such objects should be allocated on the heap.
+    CAVE_ASSERT(m_first_block_offset + 8 * m_block_byte_count <= slab_byte_count);
+
+    get_magazine_index_registry().register_pool(this);
+}
+
+FixedSizePoolAllocator::~FixedSizePoolAllocator()
+{
+    get_magazine_index_registry().unregister_pool(this);
+
+    SlabHeader* region = m_regions;
+    while (region)
+    {
+        SlabHeader* next_region = region->next_region;
+        PlatformCore::release_virtual_memory(region->region_address, region_reserved_byte_count);
+        region = next_region;
+    }
+}
+
+void* FixedSizePoolAllocator::allocate()
+{
+    const u32 magazine_index = get_thread_magazine_index();
+    if (magazine_index == invalid_magazine_index)
+    {
+        std::scoped_lock lock(m_mutex);
+        return allocate_from_shared_list();
+    }
+
+    Magazine& magazine = m_magazines[magazine_index];
+    if (magazine.count == 0)
+    {
+        std::scoped_lock lock(m_mutex);
+        refill_magazine(magazine);
+        if (magazine.count == 0)
+            return nullptr;
+    }
+
+    return magazine.blocks[--magazine.count];
+}
+
+void FixedSizePoolAllocator::release(void* block)
+{
+    if (!block)
+        return;
+    CAVE_ASSERT(get_owning_pool(block) == this);
+
+    const u32 magazine_index = get_thread_magazine_index();
+    if (magazine_index == invalid_magazine_index)
+    {
+        std::scoped_lock lock(m_mutex);
+        FreeBlock* free_block = static_cast<FreeBlock*>(block);
+        free_block->next = m_free_list;
+        m_free_list = free_block;
+        return;
+    }
+
+    Magazine& magazine = m_magazines[magazine_index];
+    if (magazine.count == magazine_capacity)
+        flush_magazine(magazine, magazine_batch_count);
+
+    magazine.blocks[magazine.count++] = block;
+}
+
+void FixedSizePoolAllocator::release_to_owning_pool(void* block)
+{
+    if (block)
+        get_owning_pool(block)->release(block);
+}
+
+FixedSizePoolAllocator* FixedSizePoolAllocator::get_owning_pool(const void* block)
+{
+    // The slabs are aligned to their size, so the slab header is located at the address rounded down to the slab size.
+    const uintptr slab_address = reinterpret_cast<uintptr>(block) & ~static_cast<uintptr>(slab_byte_count - 1);
+    return reinterpret_cast<const SlabHeader*>(slab_address)->pool;
+}
+
+usize FixedSizePoolAllocator::slab_count() const
+{
+    std::scoped_lock lock(m_mutex);
+    return m_slab_count;
+}
+
+void FixedSizePoolAllocator::refill_magazine(Magazine& magazine)
+{
+    while (magazine.count < magazine_batch_count)
+    {
+        void* block = allocate_from_shared_list();
+        if (!block)
+            return;
+        magazine.blocks[magazine.count++] = block;
+    }
+}
+
+void FixedSizePoolAllocator::flush_magazine(Magazine& magazine, u32 block_count)
+{
+    CAVE_ASSERT(block_count <= magazine.count);
+
+    // Link the blocks together before taking the lock, so that the critical section is as short as possible.
+    FreeBlock* first_block = static_cast<FreeBlock*>(magazine.blocks[magazine.count - 1]);
+    FreeBlock* last_block = first_block;
+    for (u32 index = 1; index < block_count; ++index)
+    {
+        FreeBlock* block = static_cast<FreeBlock*>(magazine.blocks[magazine.count - 1 - index]);
+        last_block->next = block;
+        last_block = block;
+    }
+    magazine.count -= block_count;
+
+    std::scoped_lock lock(m_mutex);
+    last_block->next = m_free_list;
+    m_free_list = first_block;
+}
+
+void FixedSizePoolAllocator::flush_thread_magazine(u32 magazine_index)
+{
+    Magazine& magazine = m_magazines[magazine_index];
+    if (magazine.count > 0)
+        flush_magazine(magazine, magazine.count);
+}
+
+void* FixedSizePoolAllocator::allocate_from_shared_list()
+{
+    if (m_free_list)
+    {
+        FreeBlock* block = m_free_list;
+        m_free_list = block->next;
+        return block;
+    }
+
+    if (m_unused_begin + m_block_byte_count > m_unused_end)
+    {
+        // The current slab is exhausted, so commit a new one. The blocks are carved from it only when needed,
+        // so that the pages of the slab are not touched before they are actually used.
+        u8* slab_memory = commit_next_slab();
+        if (!slab_memory)
+            return nullptr;
+
+        m_unused_begin = slab_memory + m_first_block_offset;
+        m_unused_end = slab_memory + slab_byte_count;
+    }
+
+    void* block = m_unused_begin;
+    m_unused_begin += m_block_byte_count;
+    return block;
+}
+
+u8* FixedSizePoolAllocator::commit_next_slab()
+{
+    void* region_address = nullptr;
+    if (m_uncommitted_begin == m_uncommitted_end)
+    {
+        // All slabs of the current region have been committed, so reserve a new region.
+        region_address = PlatformCore::reserve_virtual_memory(region_reserved_byte_count);
+        if (!region_address)
+            return nullptr;
+
+        m_uncommitted_begin = reinterpret_cast<u8*>(Math::align_up(reinterpret_cast<uintptr>(region_address), slab_byte_count));
+        m_uncommitted_end = m_uncommitted_begin + slabs_per_region * slab_byte_count;
+    }
+
+    u8* slab_memory = m_uncommitted_begin;
+    if (!PlatformCore::commit_virtual_memory(slab_memory, slab_byte_count))
+    {
+        if (region_address)
+        {
+            PlatformCore::release_virtual_memory(region_address, region_reserved_byte_count);
+            m_uncommitted_begin = nullptr;
+            m_uncommitted_end = nullptr;
+        }
+        return nullptr;
+    }
+    m_uncommitted_begin += slab_byte_count;
+
+    SlabHeader* slab = new (slab_memory) SlabHeader();
+    slab->pool = this;
+    slab->region_address = nullptr;
+    slab->next_region = nullptr;
+    if (region_address)
+    {
+        slab->region_address = region_address;
+        slab->next_region = m_regions;
+        m_regions = slab;
+    }
+
+    ++m_slab_count;
+    return slab_memory;
+}
+
+} // namespace CaveGame
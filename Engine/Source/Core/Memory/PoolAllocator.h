@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+#include <mutex>
+#include <new>
+
+namespace CaveGame
+{
+
+//
+// Allocator that serves memory blocks of a single, fixed size. Ideal for objects that are created and destroyed often,
+// such as entities, particles, chunk metadata or job descriptors, as it never fragments the heap.
+//
+// The blocks are carved from slabs of `slab_byte_count` bytes, which are aligned to their size. Each slab starts with a
+// header that references the pool that owns it, so the owning pool of any block can be found from the block address.
+// The slabs are committed one at a time from regions of reserved virtual memory, which hold `slabs_per_region` slabs.
+// The free blocks form an intrusive singly linked list (the first bytes of a free block store the next free block).
+//
+// Each thread has a small cache of free blocks (a magazine), so most allocations and releases don't touch any shared
+// state. The magazines are refilled from (or flushed to) the shared free list in batches, under a lock.
+// NOTE: Only the first `max_thread_count` threads that use the pools at the same time get magazines. Any additional
+// thread allocates and releases directly from the shared free list.
+//
+class FixedSizePoolAllocator
+{
+    CAVE_MAKE_NONCOPYABLE(FixedSizePoolAllocator);
+    CAVE_MAKE_NONMOVABLE(FixedSizePoolAllocator);
+    friend class MagazineIndexRegistry;
+
+public:
+    static constexpr usize slab_byte_count = 64 * KiB;
+    static constexpr usize slabs_per_region = 64;
+    static constexpr u32 max_thread_count = 64;
+    static constexpr u32 magazine_capacity = 32;
+
+public:
+    FixedSizePoolAllocator(usize block_byte_count, usize block_alignment);
+
+    //
+    // Releases all slabs owned by the pool. All blocks must have been released before the pool is destroyed.
+    // NOTE: The destructors of the objects that still live in the pool are not invoked.
+    //
+    ~FixedSizePoolAllocator();
+
+public:
+    // Allocates a memory block. Never returns nullptr, unless the system is out of memory.
+    NODISCARD void* allocate();
+
+    // Releases a memory block that has been allocated by this pool.
+    void release(void* block);
+
+    // Releases a memory block to the pool that has allocated it.
+    static void release_to_owning_pool(void* block);
+
+    // Returns the pool that has allocated the given memory block.
+    NODISCARD static FixedSizePoolAllocator* get_owning_pool(const void* block);
+
+public:
+    NODISCARD ALWAYS_INLINE usize block_byte_count() const { return m_block_byte_count; }
+    NODISCARD ALWAYS_INLINE usize block_alignment() const { return m_block_alignment; }
+
+    // Returns the number of slabs allocated by the pool. Slabs are only released when the pool is destroyed.
+    NODISCARD usize slab_count() const;
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct SlabHeader
+    {
+        FixedSizePoolAllocator* pool;
+        // The following members are only set in the first slab of a region, which describes the region.
+        void* region_address;
+        SlabHeader* next_region;
+    };
+
+    struct alignas(64) Magazine
+    {
+        u32 count;
+        void* blocks[magazine_capacity];
+    };
+
+    // Moves a batch of free blocks from the shared free list to the given magazine. Requires the lock to be held.
+    void refill_magazine(Magazine& magazine);
+
+    // Moves a batch of free blocks from the given magazine to the shared free list.
+    void flush_magazine(Magazine& magazine, u32 block_count);
+
+    // Moves all free blocks from the magazine with the given index to the shared free list. Called when a thread exits.
+    void flush_thread_magazine(u32 magazine_index);
+
+    // Returns a free block from the shared list, allocating a new slab if required. Requires the lock to be held.
+    // Returns nullptr if a new slab was required, but it couldn't be allocated.
+    NODISCARD void* allocate_from_shared_list();
+
+    // Commits the next slab of the current region, reserving a new region if required. Requires the lock to be held.
+    // Returns nullptr if the virtual memory couldn't be reserved or committed.
+    NODISCARD u8* commit_next_slab();
+
+private:
+    usize m_block_byte_count;
+    usize m_block_alignment;
+    // The offset of the first block in a slab, after the slab header.
+    usize m_first_block_offset;
+
+    mutable std::mutex m_mutex;
+    FreeBlock* m_free_list { nullptr };
+    // The first slabs of all regions reserved by the pool, linked through their `next_region` member.
+    SlabHeader* m_regions { nullptr };
+    usize m_slab_count { 0 };
+    // The range of the most recently reserved region that hasn't been committed yet.
+    u8* m_uncommitted_begin { nullptr };
+    u8* m_uncommitted_end { nullptr };
+    // The range of the most recently allocated slab that hasn't been carved into blocks yet.
+    u8* m_unused_begin { nullptr };
+    u8* m_unused_end { nullptr };
+
+    Magazine m_magazines[max_thread_count] {};
+
+    // The list of all live pools, whose magazines are flushed when a thread exits. Protected by the index registry lock.
+    FixedSizePoolAllocator* m_previous_pool { nullptr };
+    FixedSizePoolAllocator* m_next_pool { nullptr };
+};
+
+//
+// Pool allocator for objects of type `T`. See `FixedSizePoolAllocator` for the allocation strategy.
+//
+// Types that declare `CAVE_DECLARE_POOL_ALLOCATED` are always allocated from a pool, even when created with
+// `create_own` or `create_ref`, and their memory is returned to the owning pool when the OwnPtr or RefPtr deletes
+// them. Objects of such types created with `create` on a specific pool can therefore be adopted by OwnPtr and RefPtr.
+//
+template<typename T>
+class PoolAllocator
+{
+    CAVE_MAKE_NONCOPYABLE(PoolAllocator);
+    CAVE_MAKE_NONMOVABLE(PoolAllocator);
+
+public:
+    ALWAYS_INLINE PoolAllocator()
+        : m_pool(sizeof(T), alignof(T))
+    {}
+
+    //
+    // Returns the pool used by `operator new` of the types that declare `CAVE_DECLARE_POOL_ALLOCATED`.
+    // NOTE: The global pool is intentionally never destroyed, as objects might be released during static destruction.
+    //
+    NODISCARD static PoolAllocator& get_global()
+    {
+        static PoolAllocator* s_global_pool = new PoolAllocator();
+        return *s_global_pool;
+    }
+
+public:
+    // Allocates (uninitialized) memory for an instance of type `T`.
+    NODISCARD ALWAYS_INLINE T* allocate() { return static_cast<T*>(m_pool.allocate()); }
+
+    // Releases memory that has been allocated by this pool, without invoking any destructor.
+    ALWAYS_INLINE void release(T* instance) { m_pool.release(instance); }
+
+    //
+    // Creates an instance of type `T` in the pool, by forwarding the provided parameters to its constructor.
+    // The program is terminated if the pool is out of memory, as the constructor can't be invoked on nullptr.
+    //
+    template<typename... Args>
+    NODISCARD ALWAYS_INLINE T* create(Args&&... args)
+    {
+        void* block = m_pool.allocate();
+        CAVE_VERIFY(block != nullptr);
+        // NOTE: The global placement new must be used, as `T` might declare its own `operator new`.
+        return ::new (block) T(forward<Args>(args)...);
+    }
+
+    // Destroys an instance created by this pool and releases its memory.
+    ALWAYS_INLINE void destroy(T* instance)
+    {
+        if (instance)
+        {
+            instance->~T();
+            m_pool.release(instance);
+        }
+    }
+
+    NODISCARD ALWAYS_INLINE FixedSizePoolAllocator& get_pool() { return m_pool; }
+
+private:
+    FixedSizePoolAllocator m_pool;
+};
+
+namespace Detail
+{
+
+template<typename T>
+NODISCARD ALWAYS_INLINE void* allocate_pool_object(usize byte_count)
+{
+    // A derived type that doesn't declare its own pool allocation has a different size, so it is allocated on the heap.
+    if (byte_count != sizeof(T))
+        return ::operator new(byte_count);
+
+    // NOTE: The class-specific `operator new` isn't `noexcept`, so the new-expression doesn't check its result for nullptr.
+    // The program is terminated instead, the same way the global `operator new` fails when exceptions are disabled.
+    void* block = PoolAllocator<T>::get_global().allocate();
+    CAVE_VERIFY(block != nullptr);
+    return block;
+}
+
+template<typename T>
+ALWAYS_INLINE void release_pool_object(void* block, usize byte_count)
+{
+    if (byte_count != sizeof(T))
+    {
+        ::operator delete(block, byte_count);
+        return;
+    }
+
+    // The block might have been allocated from any pool of this type, not only the global one.
+    FixedSizePoolAllocator::release_to_owning_pool(block);
+}
+
+} // namespace Detail
+
+} // namespace CaveGame
+
+//
+// Declares the class-specific `operator new` and `operator delete` of the type in which this macro is placed, such that
+// its instances are allocated from `PoolAllocator<type_name>::get_global()` and released to their owning pool.
+// The deletion is redirected even when performed by an OwnPtr or RefPtr, so no custom deleter is required.
+// NOTE: If the type is polymorphic, its destructor must be virtual, as the size of the instance selects the allocator.
+// NOTE: The `operator new` never returns nullptr. If the pool is out of memory, the program is terminated.
+// NOTE: The declarations following this macro are public.
+//
+#define CAVE_DECLARE_POOL_ALLOCATED(type_name)                                                                                    \
+public:                                                                                                                           \
+    static void* operator new(::CaveGame::usize byte_count) { return ::CaveGame::Detail::allocate_pool_object<type_name>(byte_count); } \
+    static void operator delete(void* block, ::CaveGame::usize byte_count) { ::CaveGame::Detail::release_pool_object<type_name>(block, byte_count); }
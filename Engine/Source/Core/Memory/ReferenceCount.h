@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+#include <atomic>
+
+namespace CaveGame
+{
+
+//
+// Reference count that can be safely incremented and decremented from multiple threads.
+//
+// Taking a new reference requires no ordering, as the caller already holds a reference (so the object can't be
+// destroyed concurrently). The decrement uses release semantics, so that all accesses made through the released
+// reference happen before the object is destroyed, and the thread that drops the last reference performs an acquire
+// fence before it destroys the object.
+//
+class AtomicReferenceCount
+{
+    CAVE_MAKE_NONCOPYABLE(AtomicReferenceCount);
+    CAVE_MAKE_NONMOVABLE(AtomicReferenceCount);
+
+public:
+    ALWAYS_INLINE explicit AtomicReferenceCount(u32 initial_count = 0)
+        : m_count(initial_count)
+    {}
+
+    ALWAYS_INLINE void increment() { m_count.fetch_add(1, std::memory_order_relaxed); }
+
+    //
+    // Returns true if the reference count hits zero after the decrement operation, signaling
+    // that the instance should be deleted as it is not referenced by anyone.
+    //
+    NODISCARD ALWAYS_INLINE bool decrement()
+    {
+        MAYBE_UNUSED const u32 previous_count = m_count.fetch_sub(1, std::memory_order_release);
+        // Decrementing the reference count of an instance that should have been deleted is not valid.
+        CAVE_DEBUG_ASSERT(previous_count > 0);
+
+        if (previous_count != 1)
+            return false;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return true;
+    }
+
+    //
+    // Increments the reference count only if it is not zero. Returns false if the count is zero, which means that the
+    // instance is being (or has been) destroyed, so no new reference can be taken.
+    //
+    NODISCARD ALWAYS_INLINE bool try_increment_if_not_zero()
+    {
+        u32 count = m_count.load(std::memory_order_relaxed);
+        while (count != 0)
+        {
+            if (m_count.compare_exchange_weak(count, count + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+    // NOTE: The value might be outdated by the time it is used, so it should only be used for diagnostics.
+    NODISCARD ALWAYS_INLINE u32 get() const { return m_count.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<u32> m_count;
+};
+
+//
+// Reference count that can only be used from a single thread at a time. It is cheaper than the atomic reference count,
+// as no read-modify-write instructions are needed, so it should be used for hot objects that never cross threads.
+//
+class NonAtomicReferenceCount
+{
+    CAVE_MAKE_NONCOPYABLE(NonAtomicReferenceCount);
+    CAVE_MAKE_NONMOVABLE(NonAtomicReferenceCount);
+
+public:
+    ALWAYS_INLINE explicit NonAtomicReferenceCount(u32 initial_count = 0)
+        : m_count(initial_count)
+    {}
+
+    ALWAYS_INLINE void increment() { ++m_count; }
+
+    //
+    // Returns true if the reference count hits zero after the decrement operation, signaling
+    // that the instance should be deleted as it is not referenced by anyone.
+    //
+    NODISCARD ALWAYS_INLINE bool decrement()
+    {
+        // Decrementing the reference count of an instance that should have been deleted is not valid.
+        CAVE_DEBUG_ASSERT(m_count > 0);
+
+        --m_count;
+        return (m_count == 0);
+    }
+
+    NODISCARD ALWAYS_INLINE bool try_increment_if_not_zero()
+    {
+        if (m_count == 0)
+            return false;
+        ++m_count;
+        return true;
+    }
+
+    NODISCARD ALWAYS_INLINE u32 get() const { return m_count; }
+
+private:
+    u32 m_count;
+};
+
+} // namespace CaveGame
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Math/MathCore.h>
+#include <Core/Memory/VirtualArena.h>
+#include <Core/Platform/PlatformCore.h>
+
+namespace CaveGame
+{
+
+VirtualArena::~VirtualArena()
+{
+    shutdown();
+}
+
+bool VirtualArena::initialize(usize reserved_byte_count, usize commit_granularity, bool use_large_pages)
+{
+    if (m_base_address)
+    {
+        // The arena has already been initialized.
+        return false;
+    }
+
+    // The commit granularity must be a power of two.
+    CAVE_ASSERT(commit_granularity > 0 && (commit_granularity & (commit_granularity - 1)) == 0);
+
+    const usize page_size = PlatformCore::get_virtual_memory_page_size();
+    const usize large_page_size = PlatformCore::get_large_page_size();
+    if (commit_granularity < page_size)
+        commit_granularity = page_size;
+
+    // NOTE: Only the ranges aligned to the large page size can be backed by large pages, so the region is over-reserved
+    // by one large page and the base address of the arena is aligned up inside it.
+    const usize base_alignment = (use_large_pages && large_page_size != 0) ? large_page_size : page_size;
+    reserved_byte_count = Math::align_up(reserved_byte_count, base_alignment);
+    const usize reservation_byte_count = reserved_byte_count + ((base_alignment > page_size) ? base_alignment : 0);
+
+    void* reservation_address = PlatformCore::reserve_virtual_memory(reservation_byte_count);
+    if (!reservation_address)
+        return false;
+
+    m_base_address = reinterpret_cast<u8*>(Math::align_up(reinterpret_cast<uintptr>(reservation_address), base_alignment));
+    m_reservation_address = reservation_address;
+    m_reservation_byte_count = reservation_byte_count;
+    m_reserved_byte_count = reserved_byte_count;
+    m_committed_byte_count = 0;
+    m_uses_large_pages = use_large_pages && (large_page_size != 0) && PlatformCore::advise_large_pages(m_base_address, m_reserved_byte_count);
+
+    // Committing less than a large page at once would split the large pages, so the granularity is only raised when
+    // the range is actually backed by large pages.
+    if (m_uses_large_pages && large_page_size > commit_granularity)
+        commit_granularity = large_page_size;
+    m_commit_granularity = commit_granularity;
+    return true;
+}
+
+void VirtualArena::shutdown()
+{
+    if (!m_base_address)
+    {
+        // The arena has already been shut down.
+        return;
+    }
+
+    PlatformCore::release_virtual_memory(m_reservation_address, m_reservation_byte_count);
+    m_base_address = nullptr;
+    m_reserved_byte_count = 0;
+    m_reservation_address = nullptr;
+    m_reservation_byte_count = 0;
+    m_committed_byte_count = 0;
+    m_uses_large_pages = false;
+}
+
+void VirtualArena::decommit_after(usize byte_count)
+{
+    const usize new_committed_byte_count = Math::align_up(byte_count, m_commit_granularity);
+    if (new_committed_byte_count >= m_committed_byte_count)
+        return;
+
+    u8* decommit_address = m_base_address + new_committed_byte_count;
+    const usize decommit_byte_count = m_committed_byte_count - new_committed_byte_count;
+    PlatformCore::decommit_virtual_memory(decommit_address, decommit_byte_count);
+    m_committed_byte_count = new_committed_byte_count;
+
+    // NOTE: On some platforms decommitting replaces the pages, which drops the large page hint of the range.
+    if (m_uses_large_pages)
+        PlatformCore::advise_large_pages(decommit_address, decommit_byte_count);
+}
+
+bool VirtualArena::commit(usize byte_count)
+{
+    if (byte_count > m_reserved_byte_count)
+        return false;
+
+    usize new_committed_byte_count = Math::align_up(byte_count, m_commit_granularity);
+    if (new_committed_byte_count > m_reserved_byte_count)
+        new_committed_byte_count = m_reserved_byte_count;
+
+    u8* commit_address = m_base_address + m_committed_byte_count;
+    if (!PlatformCore::commit_virtual_memory(commit_address, new_committed_byte_count - m_committed_byte_count))
+        return false;
+
+    m_committed_byte_count = new_committed_byte_count;
+    return true;
+}
+
+} // namespace CaveGame
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+//
+// A contiguous range of virtual memory that grows in place, by committing pages at its end.
+//
+// The whole range is reserved up-front, so the base address never changes and the memory is never copied when the
+// arena grows. This makes it the building block for growable structures that must keep stable pointers (such as the
+// linear allocators, or arrays of chunk metadata). The pages past the committed range are inaccessible, so any access
+// past the end of the arena faults immediately instead of silently corrupting memory.
+//
+// Pages can be decommitted to return their physical memory to the operating system, for example after a spike in
+// memory usage, while the range remains reserved so that it can grow again later.
+//
+class VirtualArena
+{
+    CAVE_MAKE_NONCOPYABLE(VirtualArena);
+    CAVE_MAKE_NONMOVABLE(VirtualArena);
+
+public:
+    // The arena commits pages in blocks of (at least) this size, in order to reduce the number of system calls.
+    static constexpr usize default_commit_granularity = 64 * KiB;
+
+public:
+    VirtualArena() = default;
+    ~VirtualArena();
+
+    //
+    // Reserves the virtual memory range used by the arena. The byte count is rounded up to a multiple of the page size.
+    // If `use_large_pages` is true and the system supports them, the commit granularity is raised to the large page size
+    // and the operating system is hinted to back the range with large pages, which reduces the TLB misses of large arenas.
+    // In that case the base address and the byte count are also aligned to the large page size.
+    // Returns false if the range couldn't be reserved.
+    //
+    bool initialize(usize reserved_byte_count, usize commit_granularity = default_commit_granularity, bool use_large_pages = false);
+
+    // Releases the virtual memory range used by the arena. All pointers into the arena are invalidated.
+    void shutdown();
+
+public:
+    //
+    // Ensures that the first `byte_count` bytes of the arena are committed, committing more pages if required.
+    // Returns false if the byte count exceeds the reserved range or if the pages couldn't be committed.
+    //
+    NODISCARD ALWAYS_INLINE bool ensure_committed(usize byte_count)
+    {
+        if (byte_count <= m_committed_byte_count)
+            return true;
+        return commit(byte_count);
+    }
+
+    //
+    // Decommits the pages located after the first `byte_count` bytes of the arena (rounded up to the commit granularity),
+    // returning their physical memory to the operating system. The contents of the decommitted pages are lost.
+    //
+    void decommit_after(usize byte_count);
+
+    // Returns whether or not the given address is located inside the reserved range of the arena.
+    NODISCARD ALWAYS_INLINE bool owns(const void* address) const
+    {
+        const u8* byte_address = static_cast<const u8*>(address);
+        return (byte_address >= m_base_address) && (byte_address < m_base_address + m_reserved_byte_count);
+    }
+
+public:
+    NODISCARD ALWAYS_INLINE u8* base_address() const { return m_base_address; }
+    NODISCARD ALWAYS_INLINE bool is_initialized() const { return (m_base_address != nullptr); }
+
+    NODISCARD ALWAYS_INLINE usize reserved_byte_count() const { return m_reserved_byte_count; }
+    NODISCARD ALWAYS_INLINE usize committed_byte_count() const { return m_committed_byte_count; }
+
+private:
+    NODISCARD bool commit(usize byte_count);
+
+private:
+    u8* m_base_address { nullptr };
+    usize m_reserved_byte_count { 0 };
+    // The region actually reserved from the system, which is larger than the usable range when it had to be aligned.
+    void* m_reservation_address { nullptr };
+    usize m_reservation_byte_count { 0 };
+    usize m_committed_byte_count { 0 };
+    usize m_commit_granularity { default_commit_granularity };
+    bool m_uses_large_pages { false };
+};
+
+} // namespace CaveGame
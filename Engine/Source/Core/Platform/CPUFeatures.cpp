@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Platform/CPUFeatures.h>
+
+#if CAVE_ARCHITECTURE_X64
+    #if CAVE_COMPILER_MSVC
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif // CAVE_COMPILER_MSVC
+#endif // CAVE_ARCHITECTURE_X64
+
+namespace CaveGame
+{
+
+#if CAVE_ARCHITECTURE_X64
+
+// Executes the `cpuid` instruction for the given leaf and sub-leaf. The registers are stored as EAX, EBX, ECX, EDX.
+static void x64_cpuid(u32 leaf, u32 sub_leaf, u32 out_registers[4])
+{
+    #if CAVE_COMPILER_MSVC
+    int registers[4];
+    __cpuidex(registers, static_cast<int>(leaf), static_cast<int>(sub_leaf));
+    for (usize index = 0; index < 4; ++index)
+        out_registers[index] = static_cast<u32>(registers[index]);
+    #else
+    __cpuid_count(leaf, sub_leaf, out_registers[0], out_registers[1], out_registers[2], out_registers[3]);
+    #endif // CAVE_COMPILER_MSVC
+}
+
+// Reads the extended control register 0 (XCR0), which stores the register states saved by the operating system.
+static u64 x64_read_xcr0()
+{
+    #if CAVE_COMPILER_MSVC
+    return _xgetbv(0);
+    #else
+    u32 eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<u64>(edx) << 32) | eax;
+    #endif // CAVE_COMPILER_MSVC
+}
+
+//
+// Returns the size of the largest data (or unified) cache described by the given deterministic cache parameters leaf,
+// which is leaf 4 on Intel and leaf 0x8000001D on AMD. Each sub-leaf describes one cache, until a null cache is found.
+//
+static usize x64_detect_last_level_cache_byte_count(u32 cache_parameters_leaf)
+{
+    usize largest_cache_byte_count = 0;
+    for (u32 sub_leaf = 0; sub_leaf < 16; ++sub_leaf)
+    {
+        u32 registers[4];
+        x64_cpuid(cache_parameters_leaf, sub_leaf, registers);
+
+        const u32 cache_type = registers[0] & 0x1F;
+        if (cache_type == 0)
+        {
+            // There are no more caches to enumerate.
+            break;
+        }
+
+        // The instruction caches are not relevant.
+        if (cache_type == 2)
+            continue;
+
+        const usize way_count = ((registers[1] >> 22) & 0x3FF) + 1;
+        const usize partition_count = ((registers[1] >> 12) & 0x3FF) + 1;
+        const usize line_byte_count = (registers[1] & 0xFFF) + 1;
+        const usize set_count = static_cast<usize>(registers[2]) + 1;
+
+        const usize cache_byte_count = way_count * partition_count * line_byte_count * set_count;
+        if (cache_byte_count > largest_cache_byte_count)
+            largest_cache_byte_count = cache_byte_count;
+    }
+
+    return largest_cache_byte_count;
+}
+
+static CPUFeatures detect_cpu_features()
+{
+    CPUFeatures features;
+
+    u32 registers[4];
+    x64_cpuid(0, 0, registers);
+    const u32 max_leaf = registers[0];
+
+    // The vendor string is stored in EBX, EDX and ECX. Only its first four characters are compared.
+    const bool is_intel = (registers[1] == 0x756E6547); // "Genu"
+    const bool is_amd = (registers[1] == 0x68747541); // "Auth"
+
+    x64_cpuid(0x80000000, 0, registers);
+    const u32 max_extended_leaf = registers[0];
+
+    x64_cpuid(1, 0, registers);
+    const u32 leaf1_ecx = registers[2];
+    const u32 leaf1_edx = registers[3];
+
+    features.has_sse2 = (leaf1_edx & (1U << 26)) != 0;
+    features.has_sse4_2 = (leaf1_ecx & (1U << 20)) != 0;
+    features.has_popcnt = (leaf1_ecx & (1U << 23)) != 0;
+
+    // The operating system must support the `xgetbv` instruction (OSXSAVE) and save both the XMM and YMM
+    // registers on context switches, otherwise the AVX instructions can't be used.
+    const bool has_os_xsave = (leaf1_ecx & (1U << 27)) != 0;
+    const bool has_avx = (leaf1_ecx & (1U << 28)) != 0;
+    const bool os_saves_ymm_registers = has_os_xsave && ((x64_read_xcr0() & 0x6) == 0x6);
+
+    if (max_leaf >= 7)
+    {
+        x64_cpuid(7, 0, registers);
+        const u32 leaf7_ebx = registers[1];
+
+        features.has_bmi1 = (leaf7_ebx & (1U << 3)) != 0;
+        features.has_bmi2 = (leaf7_ebx & (1U << 8)) != 0;
+        features.has_avx2 = has_avx && os_saves_ymm_registers && ((leaf7_ebx & (1U << 5)) != 0);
+    }
+
+    if (is_intel && max_leaf >= 4)
+    {
+        features.last_level_cache_byte_count = x64_detect_last_level_cache_byte_count(4);
+    }
+    else if (is_amd && max_extended_leaf >= 0x8000001D)
+    {
+        // The cache parameters leaf is only available if the CPU supports the topology extensions.
+        x64_cpuid(0x80000001, 0, registers);
+        const u32 extended_leaf1_ecx = registers[2];
+        if ((extended_leaf1_ecx & (1U << 22)) != 0)
+            features.last_level_cache_byte_count = x64_detect_last_level_cache_byte_count(0x8000001D);
+    }
+
+    return features;
+}
+
+#else
+
+static CPUFeatures detect_cpu_features()
+{
+    return {};
+}
+
+#endif // CAVE_ARCHITECTURE_X64
+
+const CPUFeatures& get_cpu_features()
+{
+    static const CPUFeatures s_cpu_features = detect_cpu_features();
+    return s_cpu_features;
+}
+
+} // namespace CaveGame
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+//
+// The instruction set extensions supported by the CPU the program is running on, and the size of its caches.
+// On architectures other than x64, all flags are false and the cache sizes are zero.
+//
+struct CPUFeatures
+{
+    // NOTE: SSE2 is part of the x64 baseline, so this is always true on x64.
+    bool has_sse2 { false };
+    bool has_sse4_2 { false };
+    bool has_popcnt { false };
+    bool has_bmi1 { false };
+    bool has_bmi2 { false };
+
+    // NOTE: AVX2 is only reported as supported if the operating system also saves the YMM registers.
+    bool has_avx2 { false };
+
+    // The size of the largest data (or unified) cache, which is usually the L3 cache, or zero if it couldn't be detected.
+    usize last_level_cache_byte_count { 0 };
+};
+
+//
+// Returns the instruction set extensions supported by the CPU.
+// The features are only detected once, the first time this function is called. Calling it from
+// multiple threads at the same time is safe.
+//
+NODISCARD const CPUFeatures& get_cpu_features();
+
+} // namespace CaveGame
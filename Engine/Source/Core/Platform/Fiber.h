@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Assertion.h>
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+//
+// A user-mode execution context with its own stack. Switching between fibers only saves and restores the callee-saved
+// registers, so it is much cheaper than switching between threads and never involves the operating system scheduler.
+// A fiber can be suspended on one thread and resumed on any other thread.
+//
+// Implementations:
+//   - Windows: the native fiber API.
+//   - Linux (x64 and ARM64): a hand-written context switch, which saves the callee-saved registers on the stack of the
+//     suspended fiber.
+//   - Linux (other architectures): the `ucontext` API, which is slower as it also saves the signal mask.
+//
+// On Linux, the fiber stacks are allocated from virtual memory and the lowest page of each stack is never committed, so
+// a stack overflow faults immediately instead of corrupting the memory located below the stack. On Windows, the stacks
+// are allocated by the operating system, which provides the same guarantee.
+//
+class Fiber
+{
+    CAVE_MAKE_NONCOPYABLE(Fiber);
+    CAVE_MAKE_NONMOVABLE(Fiber);
+
+public:
+    using EntryFunction = void (*)(void* user_data);
+
+    static constexpr usize default_stack_byte_count = 256 * KiB;
+
+public:
+    Fiber() = default;
+    ~Fiber();
+
+    //
+    // Creates a fiber that invokes the entry function the first time it is switched to. The entry function must never
+    // return; instead, it must switch to another fiber once it has finished.
+    // Returns false if the stack couldn't be allocated.
+    //
+    NODISCARD bool initialize(EntryFunction entry_function, void* user_data, usize stack_byte_count = default_stack_byte_count);
+
+    //
+    // Turns the calling thread into a fiber, so that it can switch to other fibers. The fiber uses the stack of the thread
+    // and can only be resumed on the same thread. Must be shut down on the same thread as well.
+    //
+    NODISCARD bool initialize_from_current_thread();
+
+    void shutdown();
+
+public:
+    //
+    // Suspends the calling fiber (which must be this fiber) and resumes the target fiber. The function returns when
+    // another fiber switches back to this fiber, possibly on a different thread.
+    //
+    void switch_to(Fiber& target);
+
+    NODISCARD ALWAYS_INLINE bool is_initialized() const { return m_is_initialized; }
+
+private:
+    //
+    // The platform-specific execution context of the fiber:
+    //   - Windows: the fiber handle.
+    //   - Linux (x64 and ARM64): the saved stack pointer of the suspended fiber.
+    //   - Linux (other architectures): the heap-allocated `ucontext_t` structure.
+    //
+    void* m_context { nullptr };
+
+    // The virtual memory range of the stack (including the guard page). Null for the fibers created from threads and
+    // for the fibers whose stack is allocated by the operating system.
+    u8* m_stack_base_address { nullptr };
+    usize m_stack_reserved_byte_count { 0 };
+
+    bool m_is_initialized { false };
+    bool m_is_thread_fiber { false };
+};
+
+} // namespace CaveGame
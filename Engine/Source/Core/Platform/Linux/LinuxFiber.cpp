@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Math/MathCore.h>
+    #include <Core/Platform/Fiber.h>
+    #include <Core/Platform/PlatformCore.h>
+
+    //
+    // The hand-written context switch is only available on x64 and ARM64. On any other architecture the fibers are
+    // always backed by the `ucontext` API.
+    //
+    #ifndef CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+        #if CAVE_ARCHITECTURE_X64 || CAVE_ARCHITECTURE_ARM64
+            #define CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH 1
+        #else
+            #define CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH 0
+        #endif // CAVE_ARCHITECTURE_X64 || CAVE_ARCHITECTURE_ARM64
+    #endif // CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+
+    #if !CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+        #include <stdlib.h>
+        #include <ucontext.h>
+    #endif // !CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+
+namespace CaveGame
+{
+
+    #if CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+
+//
+// Saves the callee-saved registers of the calling fiber on its stack, stores its stack pointer in `out_stack_pointer`
+// and restores the fiber whose stack pointer is `stack_pointer`. Returns when another fiber switches back.
+//
+// A fiber that has never run has a stack prepared by `prepare_fiber_stack`, which makes the restore sequence "return"
+// into `cave_fiber_entry_trampoline` with the entry function and the user data in two callee-saved registers.
+//
+extern "C" void cave_switch_fiber_context(void** out_stack_pointer, void* stack_pointer);
+extern "C" void cave_fiber_entry_trampoline();
+
+        #if CAVE_ARCHITECTURE_X64
+
+//
+// The System V x64 callee-saved registers are RBP, RBX and R12-R15. The control bits of MXCSR and of the x87 control word
+// are callee-saved as well, so they are stored in an additional 8-byte slot.
+//
+// Stack layout of a suspended fiber (from the saved stack pointer upwards):
+//   [MXCSR | x87 control word] [R15] [R14] [R13] [R12] [RBX] [RBP] [return address]
+//
+asm(R"(
+    .text
+    .p2align 4
+    .globl cave_switch_fiber_context
+    .hidden cave_switch_fiber_context
+    .type cave_switch_fiber_context, @function
+cave_switch_fiber_context:
+    pushq %rbp
+    pushq %rbx
+    pushq %r12
+    pushq %r13
+    pushq %r14
+    pushq %r15
+    subq $8, %rsp
+    stmxcsr (%rsp)
+    fnstcw 4(%rsp)
+    movq %rsp, (%rdi)
+    movq %rsi, %rsp
+    ldmxcsr (%rsp)
+    fldcw 4(%rsp)
+    addq $8, %rsp
+    popq %r15
+    popq %r14
+    popq %r13
+    popq %r12
+    popq %rbx
+    popq %rbp
+    ret
+    .size cave_switch_fiber_context, .-cave_switch_fiber_context
+
+    .p2align 4
+    .globl cave_fiber_entry_trampoline
+    .hidden cave_fiber_entry_trampoline
+    .type cave_fiber_entry_trampoline, @function
+cave_fiber_entry_trampoline:
+    movq %rbx, %rdi
+    jmpq *%r12
+    .size cave_fiber_entry_trampoline, .-cave_fiber_entry_trampoline
+)");
+
+// The default MXCSR (all exceptions masked, round to nearest) and x87 control word (64-bit precision, all exceptions masked).
+static constexpr u64 default_floating_point_control_word = 0x1F80 | (static_cast<u64>(0x037F) << 32);
+
+//
+// Writes the initial register frame at the top of the stack and returns the stack pointer to restore.
+// NOTE: The slot above the return address is the (null) return address of the entry function, whose stack pointer is
+// thus misaligned by 8 bytes on entry, exactly as if it had been called.
+//
+NODISCARD static void* prepare_fiber_stack(u8* stack_top, Fiber::EntryFunction entry_function, void* user_data)
+{
+    u64* frame = reinterpret_cast<u64*>(stack_top) - 9;
+    frame[0] = default_floating_point_control_word;
+    frame[1] = 0; // R15
+    frame[2] = 0; // R14
+    frame[3] = 0; // R13
+    frame[4] = reinterpret_cast<u64>(entry_function); // R12
+    frame[5] = reinterpret_cast<u64>(user_data); // RBX
+    frame[6] = 0; // RBP
+    frame[7] = reinterpret_cast<u64>(&cave_fiber_entry_trampoline);
+    frame[8] = 0;
+    return frame;
+}
+
+        #elif CAVE_ARCHITECTURE_ARM64
+
+//
+// The AAPCS64 callee-saved registers are X19-X28, the frame pointer (X29), the link register (X30) and the lower halves
+// of V8-V15 (D8-D15). The stack pointer must always be 16-byte aligned.
+//
+// Stack layout of a suspended fiber (from the saved stack pointer upwards):
+//   [X19, X20] [X21, X22] [X23, X24] [X25, X26] [X27, X28] [X29, X30] [D8, D9] [D10, D11] [D12, D13] [D14, D15]
+//
+asm(R"(
+    .text
+    .p2align 4
+    .globl cave_switch_fiber_context
+    .hidden cave_switch_fiber_context
+    .type cave_switch_fiber_context, %function
+cave_switch_fiber_context:
+    sub sp, sp, #160
+    stp x19, x20, [sp, #0]
+    stp x21, x22, [sp, #16]
+    stp x23, x24, [sp, #32]
+    stp x25, x26, [sp, #48]
+    stp x27, x28, [sp, #64]
+    stp x29, x30, [sp, #80]
+    stp d8, d9, [sp, #96]
+    stp d10, d11, [sp, #112]
+    stp d12, d13, [sp, #128]
+    stp d14, d15, [sp, #144]
+    mov x9, sp
+    str x9, [x0]
+    mov sp, x1
+    ldp x19, x20, [sp, #0]
+    ldp x21, x22, [sp, #16]
+    ldp x23, x24, [sp, #32]
+    ldp x25, x26, [sp, #48]
+    ldp x27, x28, [sp, #64]
+    ldp x29, x30, [sp, #80]
+    ldp d8, d9, [sp, #96]
+    ldp d10, d11, [sp, #112]
+    ldp d12, d13, [sp, #128]
+    ldp d14, d15, [sp, #144]
+    add sp, sp, #160
+    ret
+    .size cave_switch_fiber_context, .-cave_switch_fiber_context
+
+    .p2align 4
+    .globl cave_fiber_entry_trampoline
+    .hidden cave_fiber_entry_trampoline
+    .type cave_fiber_entry_trampoline, %function
+cave_fiber_entry_trampoline:
+    mov x0, x19
+    mov x30, xzr
+    br x20
+    .size cave_fiber_entry_trampoline, .-cave_fiber_entry_trampoline
+)");
+
+// Writes the initial register frame at the top of the stack and returns the stack pointer to restore.
+NODISCARD static void* prepare_fiber_stack(u8* stack_top, Fiber::EntryFunction entry_function, void* user_data)
+{
+    u64* frame = reinterpret_cast<u64*>(stack_top) - 20;
+    for (usize slot_index = 0; slot_index < 20; ++slot_index)
+        frame[slot_index] = 0;
+
+    frame[0] = reinterpret_cast<u64>(user_data); // X19
+    frame[1] = reinterpret_cast<u64>(entry_function); // X20
+    frame[11] = reinterpret_cast<u64>(&cave_fiber_entry_trampoline); // X30
+    return frame;
+}
+
+        #endif // CAVE_ARCHITECTURE_X64
+
+    #else
+
+//
+// The `makecontext` function can only pass `int` arguments to the entry point, so the entry function and the user data
+// are split into their lower and upper 32-bit halves.
+//
+static void fiber_entry_trampoline(u32 function_low, u32 function_high, u32 user_data_low, u32 user_data_high)
+{
+    const u64 function_address = static_cast<u64>(function_low) | (static_cast<u64>(function_high) << 32);
+    const u64 user_data_address = static_cast<u64>(user_data_low) | (static_cast<u64>(user_data_high) << 32);
+    Fiber::EntryFunction entry_function = reinterpret_cast<Fiber::EntryFunction>(static_cast<uintptr>(function_address));
+    entry_function(reinterpret_cast<void*>(static_cast<uintptr>(user_data_address)));
+
+    // The entry function must never return, as the fiber has no context to return to.
+    CAVE_ASSERT(false);
+}
+
+    #endif // CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+
+Fiber::~Fiber()
+{
+    shutdown();
+}
+
+bool Fiber::initialize(EntryFunction entry_function, void* user_data, usize stack_byte_count)
+{
+    if (m_is_initialized)
+    {
+        // The fiber has already been initialized.
+        return false;
+    }
+
+    CAVE_ASSERT(entry_function != nullptr);
+
+    // The lowest page of the reserved range is the guard page and is never committed.
+    const usize page_size = PlatformCore::get_virtual_memory_page_size();
+    stack_byte_count = Math::align_up(stack_byte_count, page_size);
+    const usize reserved_byte_count = stack_byte_count + page_size;
+
+    u8* stack_base_address = static_cast<u8*>(PlatformCore::reserve_virtual_memory(reserved_byte_count));
+    if (!stack_base_address)
+        return false;
+
+    if (!PlatformCore::commit_virtual_memory(stack_base_address + page_size, stack_byte_count))
+    {
+        PlatformCore::release_virtual_memory(stack_base_address, reserved_byte_count);
+        return false;
+    }
+
+    MAYBE_UNUSED u8* stack_top = stack_base_address + reserved_byte_count;
+
+    #if CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+    m_context = prepare_fiber_stack(stack_top, entry_function, user_data);
+    #else
+    ucontext_t* context = static_cast<ucontext_t*>(malloc(sizeof(ucontext_t)));
+    if (!context || getcontext(context) != 0)
+    {
+        free(context);
+        PlatformCore::release_virtual_memory(stack_base_address, reserved_byte_count);
+        return false;
+    }
+
+    context->uc_stack.ss_sp = stack_base_address + page_size;
+    context->uc_stack.ss_size = stack_byte_count;
+    context->uc_link = nullptr;
+
+    const u64 function_address = reinterpret_cast<uintptr>(entry_function);
+    const u64 user_data_address = reinterpret_cast<uintptr>(user_data);
+    makecontext(
+        context,
+        reinterpret_cast<void (*)()>(&fiber_entry_trampoline),
+        4,
+        static_cast<u32>(function_address),
+        static_cast<u32>(function_address >> 32),
+        static_cast<u32>(user_data_address),
+        static_cast<u32>(user_data_address >> 32)
+    );
+    m_context = context;
+    #endif // CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+
+    m_stack_base_address = stack_base_address;
+    m_stack_reserved_byte_count = reserved_byte_count;
+    m_is_initialized = true;
+    m_is_thread_fiber = false;
+    return true;
+}
+
+bool Fiber::initialize_from_current_thread()
+{
+    if (m_is_initialized)
+    {
+        // The fiber has already been initialized.
+        return false;
+    }
+
+    #if CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+    // The stack pointer is only saved when the thread fiber switches to another fiber.
+    m_context = nullptr;
+    #else
+    ucontext_t* context = static_cast<ucontext_t*>(malloc(sizeof(ucontext_t)));
+    if (!context)
+        return false;
+    m_context = context;
+    #endif // CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+
+    m_is_initialized = true;
+    m_is_thread_fiber = true;
+    return true;
+}
+
+void Fiber::shutdown()
+{
+    if (!m_is_initialized)
+    {
+        // The fiber has already been shut down.
+        return;
+    }
+
+    #if !CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+    free(m_context);
+    #endif // !CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+
+    if (m_stack_base_address)
+        PlatformCore::release_virtual_memory(m_stack_base_address, m_stack_reserved_byte_count);
+
+    m_context = nullptr;
+    m_stack_base_address = nullptr;
+    m_stack_reserved_byte_count = 0;
+    m_is_initialized = false;
+    m_is_thread_fiber = false;
+}
+
+void Fiber::switch_to(Fiber& target)
+{
+    CAVE_ASSERT(m_is_initialized && target.m_is_initialized);
+    CAVE_ASSERT(this != &target);
+
+    #if CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+    cave_switch_fiber_context(&m_context, target.m_context);
+    #else
+    swapcontext(static_cast<ucontext_t*>(m_context), static_cast<ucontext_t*>(target.m_context));
+    #endif // CAVE_ENABLE_NATIVE_FIBER_CONTEXT_SWITCH
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Assertion.h>
+    #include <Core/Platform/PlatformCore.h>
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <stdlib.h>
+    #include <sys/mman.h>
+    #include <time.h>
+    #include <unistd.h>
+
+    //
+    // The invariant TSC fast path is only available on x86-64. On any other architecture the tick counter
+    // is always backed by `clock_gettime`.
+    //
+    #ifndef CAVE_ENABLE_TSC_TICK_COUNTER
+        #if defined(__x86_64__)
+            #define CAVE_ENABLE_TSC_TICK_COUNTER 1
+        #else
+            #define CAVE_ENABLE_TSC_TICK_COUNTER 0
+        #endif // defined(__x86_64__)
+    #endif // CAVE_ENABLE_TSC_TICK_COUNTER
+
+    #if CAVE_ENABLE_TSC_TICK_COUNTER
+        #include <cpuid.h>
+        #include <x86intrin.h>
+    #endif // CAVE_ENABLE_TSC_TICK_COUNTER
+
+    #if defined(__x86_64__)
+        #include <immintrin.h>
+    #endif // defined(__x86_64__)
+
+namespace CaveGame
+{
+
+static constexpr u64 nanoseconds_per_second = 1000000000;
+
+//
+// When the CPU exposes an invariant TSC, the tick counter is read directly using `rdtsc`, which costs
+// a few nanoseconds instead of a (vDSO) call to `clock_gettime`. Otherwise, the tick counter is expressed
+// in nanoseconds, as reported by `CLOCK_MONOTONIC_RAW`.
+// Both values are only written during `PlatformCore::initialize`.
+//
+static bool s_use_tsc_tick_counter = false;
+static u64 s_tick_counter_frequency = nanoseconds_per_second;
+
+static u64 linux_get_monotonic_raw_nanoseconds()
+{
+    timespec time_spec;
+    if (clock_gettime(CLOCK_MONOTONIC_RAW, &time_spec) != 0)
+    {
+        // For some reason, the `clock_gettime` call failed.
+        CAVE_ASSERT(false);
+        return 0;
+    }
+
+    return (static_cast<u64>(time_spec.tv_sec) * nanoseconds_per_second) + static_cast<u64>(time_spec.tv_nsec);
+}
+
+    #if CAVE_ENABLE_TSC_TICK_COUNTER
+
+//
+// Returns whether or not the TSC runs at a constant rate in all ACPI P-, C- and T-states.
+// https://www.intel.com/content/www/us/en/developer/articles/technical/intel-sdm.html (CPUID leaf 80000007H, EDX bit 8)
+//
+static bool linux_is_invariant_tsc_supported()
+{
+    u32 eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007)
+    {
+        // The extended CPUID leaf that reports the TSC capabilities is not available.
+        return false;
+    }
+
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx & (1 << 8)) != 0;
+}
+
+//
+// Samples the TSC and `CLOCK_MONOTONIC_RAW` at the same moment in time. The TSC is read before and after
+// the clock query and the midpoint is used, such that the time spent in `clock_gettime` cancels out.
+//
+static void linux_sample_tsc_and_clock(u64& out_tsc, u64& out_nanoseconds)
+{
+    const u64 tsc_before = __rdtsc();
+    out_nanoseconds = linux_get_monotonic_raw_nanoseconds();
+    const u64 tsc_after = __rdtsc();
+    out_tsc = tsc_before + ((tsc_after - tsc_before) / 2);
+}
+
+//
+// Measures the TSC frequency (in ticks per second) against `CLOCK_MONOTONIC_RAW`.
+// The calibration busy-waits for a short interval, so it should only be executed once, at startup.
+//
+static u64 linux_calibrate_tsc_frequency()
+{
+    static constexpr u64 calibration_duration_nanoseconds = 20 * 1000 * 1000;
+
+    u64 begin_tsc, begin_nanoseconds;
+    linux_sample_tsc_and_clock(begin_tsc, begin_nanoseconds);
+
+    u64 end_tsc, end_nanoseconds;
+    do
+    {
+        linux_sample_tsc_and_clock(end_tsc, end_nanoseconds);
+    } while (end_nanoseconds - begin_nanoseconds < calibration_duration_nanoseconds);
+
+    const unsigned __int128 elapsed_tsc = end_tsc - begin_tsc;
+    const unsigned __int128 elapsed_nanoseconds = end_nanoseconds - begin_nanoseconds;
+    return static_cast<u64>((elapsed_tsc * nanoseconds_per_second) / elapsed_nanoseconds);
+}
+
+    #endif // CAVE_ENABLE_TSC_TICK_COUNTER
+
+bool PlatformCore::initialize()
+{
+    #if CAVE_ENABLE_TSC_TICK_COUNTER
+    if (linux_is_invariant_tsc_supported())
+    {
+        const u64 tsc_frequency = linux_calibrate_tsc_frequency();
+        if (tsc_frequency != 0)
+        {
+            s_tick_counter_frequency = tsc_frequency;
+            s_use_tsc_tick_counter = true;
+        }
+    }
+    #endif // CAVE_ENABLE_TSC_TICK_COUNTER
+
+    return true;
+}
+
+void PlatformCore::shutdown()
+{}
+
+u64 PlatformCore::get_current_tick_counter()
+{
+    #if CAVE_ENABLE_TSC_TICK_COUNTER
+    if (s_use_tsc_tick_counter)
+        return __rdtsc();
+    #endif // CAVE_ENABLE_TSC_TICK_COUNTER
+
+    return linux_get_monotonic_raw_nanoseconds();
+}
+
+u64 PlatformCore::get_tick_counter_frequency()
+{
+    CAVE_ASSERT(s_tick_counter_frequency != 0);
+    return s_tick_counter_frequency;
+}
+
+void PlatformCore::sleep_for_microseconds(u64 microseconds)
+{
+    timespec remaining_time;
+    remaining_time.tv_sec = static_cast<time_t>(microseconds / 1000000);
+    remaining_time.tv_nsec = static_cast<long>((microseconds % 1000000) * 1000);
+
+    // If the sleep is interrupted by a signal, continue sleeping for the remaining time.
+    while (nanosleep(&remaining_time, &remaining_time) != 0 && errno == EINTR)
+        ;
+}
+
+void PlatformCore::pause_processor()
+{
+    #if defined(__x86_64__)
+    _mm_pause();
+    #elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+    #endif
+}
+
+usize PlatformCore::get_virtual_memory_page_size()
+{
+    static const usize s_page_size = static_cast<usize>(sysconf(_SC_PAGESIZE));
+    return s_page_size;
+}
+
+static usize linux_query_large_page_size()
+{
+    // The size of the pages used by the transparent huge pages, which is the only large page mechanism that doesn't
+    // require the pages to be preallocated by the system administrator.
+    const int file_descriptor = open("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", O_RDONLY);
+    if (file_descriptor < 0)
+        return 0;
+
+    char buffer[32] = {};
+    const ssize_t read_byte_count = read(file_descriptor, buffer, sizeof(buffer) - 1);
+    close(file_descriptor);
+    if (read_byte_count <= 0)
+        return 0;
+
+    return static_cast<usize>(strtoull(buffer, nullptr, 10));
+}
+
+usize PlatformCore::get_large_page_size()
+{
+    static const usize s_large_page_size = linux_query_large_page_size();
+    return s_large_page_size;
+}
+
+void* PlatformCore::reserve_virtual_memory(usize byte_count)
+{
+    // NOTE: The `MAP_NORESERVE` flag prevents the kernel from accounting the whole range as committed memory.
+    void* address = mmap(nullptr, byte_count, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (address == MAP_FAILED)
+        return nullptr;
+    return address;
+}
+
+bool PlatformCore::commit_virtual_memory(void* address, usize byte_count)
+{
+    CAVE_ASSERT((reinterpret_cast<uintptr>(address) % get_virtual_memory_page_size()) == 0);
+    return (mprotect(address, byte_count, PROT_READ | PROT_WRITE) == 0);
+}
+
+void PlatformCore::decommit_virtual_memory(void* address, usize byte_count)
+{
+    CAVE_ASSERT((reinterpret_cast<uintptr>(address) % get_virtual_memory_page_size()) == 0);
+
+    // NOTE: Mapping fresh inaccessible pages over the range releases the physical memory and the commit charge of the
+    // old pages in a single system call, while keeping the range reserved.
+    MAYBE_UNUSED void* result = mmap(address, byte_count, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+    CAVE_ASSERT(result == address);
+}
+
+bool PlatformCore::advise_large_pages(MAYBE_UNUSED void* address, MAYBE_UNUSED usize byte_count)
+{
+    #if defined(MADV_HUGEPAGE)
+    return (madvise(address, byte_count, MADV_HUGEPAGE) == 0);
+    #else
+    return false;
+    #endif // defined(MADV_HUGEPAGE)
+}
+
+void PlatformCore::release_virtual_memory(void* address, usize byte_count)
+{
+    if (address == nullptr)
+        return;
+
+    MAYBE_UNUSED const int result = munmap(address, byte_count);
+    CAVE_ASSERT(result == 0);
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
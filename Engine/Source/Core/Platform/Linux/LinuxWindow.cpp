@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_LINUX
+
+    #include <Core/Assertion.h>
+    #include <Core/Platform/Window.h>
+
+namespace CaveGame
+{
+
+//
+// NOTE: There is no native windowing backend implemented on Linux yet, so only headless windows
+// can be created on this platform. Creating a native window always fails.
+//
+
+bool Window::native_initialize()
+{
+    return false;
+}
+
+void Window::native_shutdown()
+{}
+
+void Window::native_process_event_queue()
+{
+    // A native window can never be successfully initialized on Linux.
+    CAVE_ASSERT(false);
+}
+
+u32 Window::native_get_client_area_width() const
+{
+    return 0;
+}
+
+u32 Window::native_get_client_area_height() const
+{
+    return 0;
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_LINUX
@@ -15,12 +15,82 @@ namespace CaveGame
 
 class PlatformCore
 {
+public:
+    //
+    // Initializes the platform layer. Must be called before any other function of this class is used.
+    // Returns false if the platform initialization has failed.
+    //
+    static bool initialize();
+
+    //
+    // Shuts down the platform layer.
+    //
+    static void shutdown();
+
 public:
     // Returns the value of the performance counter at the moment when this function is called.
     static u64 get_current_tick_counter();
 
     // Returns the frequency of the performance counter, measured in ticks per second.
     static u64 get_tick_counter_frequency();
+
+public:
+    //
+    // Suspends the execution of the calling thread for at least the given number of microseconds.
+    // The actual sleep duration depends on the scheduler granularity and can be considerably longer,
+    // so this function should not be used when precise timing is required.
+    //
+    static void sleep_for_microseconds(u64 microseconds);
+
+    //
+    // Hints the processor that the calling thread is executing a spin-wait loop.
+    // This reduces the power consumption and the penalty of exiting the loop.
+    //
+    static void pause_processor();
+
+public:
+    // Returns the size of a virtual memory page, measured in bytes.
+    NODISCARD static usize get_virtual_memory_page_size();
+
+    //
+    // Returns the size of a large (huge) virtual memory page, measured in bytes (usually 2 MiB on x64).
+    // Returns zero if large pages are not supported by the system.
+    //
+    NODISCARD static usize get_large_page_size();
+
+    //
+    // Reserves a range of virtual address space without backing it with physical memory. The memory can't be accessed
+    // until it is committed. The byte count is rounded up to a multiple of the page size.
+    // Returns nullptr if the reservation has failed.
+    //
+    NODISCARD static void* reserve_virtual_memory(usize byte_count);
+
+    //
+    // Commits a range of pages from a reserved region, making them accessible (readable and writable).
+    // The address must be page-aligned and the range must be located inside a region reserved using `reserve_virtual_memory`.
+    // Returns false if the commit operation has failed.
+    //
+    NODISCARD static bool commit_virtual_memory(void* address, usize byte_count);
+
+    //
+    // Decommits a range of pages from a reserved region, returning their physical memory to the operating system.
+    // The range remains reserved, but can't be accessed until it is committed again (when its contents will be zero).
+    // The address must be page-aligned and the range must be located inside a region reserved using `reserve_virtual_memory`.
+    //
+    static void decommit_virtual_memory(void* address, usize byte_count);
+
+    //
+    // Hints the operating system to back the given reserved range with large pages, when they are committed.
+    // Only the parts of the range that are aligned to the large page size can use large pages.
+    // Returns false if the hint is not supported. The range is usable either way.
+    //
+    static bool advise_large_pages(void* address, usize byte_count);
+
+    //
+    // Releases a whole region reserved using `reserve_virtual_memory`, including all of its committed pages.
+    // The address and byte count must be the values used when the region was reserved.
+    //
+    static void release_virtual_memory(void* address, usize byte_count);
 };
 
 } // namespace CaveGame
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Assertion.h>
+#include <Core/Platform/PlatformCore.h>
+#include <Core/Platform/Window.h>
+
+namespace CaveGame
+{
+
+bool Window::initialize(const WindowDescription& description)
+{
+    if (m_is_initialized)
+    {
+        // The window has already been initialized.
+        return false;
+    }
+
+    m_description = description;
+    m_should_close = false;
+
+    if (is_headless())
+    {
+        m_headless_processed_frame_count = 0;
+        m_headless_start_tick_counter = PlatformCore::get_current_tick_counter();
+    }
+    else if (!native_initialize())
+    {
+        return false;
+    }
+
+    m_is_initialized = true;
+    return true;
+}
+
+void Window::shutdown()
+{
+    if (!m_is_initialized)
+    {
+        // The window has already been shut down.
+        return;
+    }
+
+    if (!is_headless())
+        native_shutdown();
+
+    m_is_initialized = false;
+}
+
+void Window::process_event_queue()
+{
+    CAVE_ASSERT(m_is_initialized);
+
+    if (!is_headless())
+    {
+        native_process_event_queue();
+        return;
+    }
+
+    // A headless window has no events to process. Instead, it closes itself once the scripted
+    // frame count or duration has been reached.
+    ++m_headless_processed_frame_count;
+
+    const u64 close_after_frame_count = m_description.headless_close_after_frame_count;
+    if (close_after_frame_count > 0 && m_headless_processed_frame_count > close_after_frame_count)
+        mark_as_should_close();
+
+    const float close_after_seconds = m_description.headless_close_after_seconds;
+    if (close_after_seconds > 0.0F)
+    {
+        const u64 elapsed_ticks = PlatformCore::get_current_tick_counter() - m_headless_start_tick_counter;
+        const float elapsed_seconds = static_cast<float>(elapsed_ticks) / static_cast<float>(PlatformCore::get_tick_counter_frequency());
+        if (elapsed_seconds >= close_after_seconds)
+            mark_as_should_close();
+    }
+}
+
+u32 Window::get_client_area_width() const
+{
+    if (is_headless())
+        return m_description.headless_client_area_width;
+    return native_get_client_area_width();
+}
+
+u32 Window::get_client_area_height() const
+{
+    if (is_headless())
+        return m_description.headless_client_area_height;
+    return native_get_client_area_height();
+}
+
+} // namespace CaveGame
@@ -13,14 +13,41 @@
 namespace CaveGame
 {
 
+enum class WindowMode : u8
+{
+    // The window is backed by a native window object, created by the platform windowing system.
+    Native = 0,
+    // The window has no native window object. Used when running on machines without a display.
+    Headless = 1,
+};
+
+struct WindowDescription
+{
+    WindowMode mode { WindowMode::Native };
+
+    // The synthetic client area size reported by a headless window.
+    u32 headless_client_area_width { 1920 };
+    u32 headless_client_area_height { 1080 };
+
+    //
+    // A headless window marks itself as should-close after processing its event queue this many times.
+    // As the event queue is processed once per frame, this is equivalent to a frame count. Zero means no limit.
+    //
+    u64 headless_close_after_frame_count { 0 };
+
+    // A headless window marks itself as should-close after this many seconds have passed. Zero means no limit.
+    float headless_close_after_seconds { 0.0F };
+};
+
 class Window
 {
 public:
     //
-    // Initializes the window by creating the native window object.
+    // Initializes the window. In native mode the native window object is created, while in headless
+    // mode no platform resources are acquired.
     // Returns false if the window initialization has failed.
     //
-    bool initialize();
+    bool initialize(const WindowDescription& description);
 
     //
     // Shuts down the window by destroying the native window object.
@@ -33,14 +60,38 @@ public:
     void process_event_queue();
 
 public:
+    NODISCARD ALWAYS_INLINE bool is_headless() const { return (m_description.mode == WindowMode::Headless); }
+
+    //
+    // Returns the native window handle.
+    // Headless windows don't have a native handle, so this function always returns nullptr for them.
+    //
     NODISCARD ALWAYS_INLINE void* get_native_handle() const { return m_native_handle; }
 
     NODISCARD u32 get_client_area_width() const;
     NODISCARD u32 get_client_area_height() const;
 
 private:
+    //
+    // Platform specific implementation of the native window mode.
+    // These functions are implemented separately for each platform.
+    //
+
+    bool native_initialize();
+    void native_shutdown();
+    void native_process_event_queue();
+    NODISCARD u32 native_get_client_area_width() const;
+    NODISCARD u32 native_get_client_area_height() const;
+
+private:
+    WindowDescription m_description;
     void* m_native_handle { nullptr };
+    bool m_is_initialized { false };
     bool m_should_close { false };
+
+    // Scripted close state, only used by headless windows.
+    u64 m_headless_processed_frame_count { 0 };
+    u64 m_headless_start_tick_counter { 0 };
 };
 
 } // namespace CaveGame
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_WINDOWS
+
+    #include <Core/Platform/Fiber.h>
+    #include <Core/Platform/Windows/WindowsGuardedInclude.h>
+
+namespace CaveGame
+{
+
+Fiber::~Fiber()
+{
+    shutdown();
+}
+
+bool Fiber::initialize(EntryFunction entry_function, void* user_data, usize stack_byte_count)
+{
+    if (m_is_initialized)
+    {
+        // The fiber has already been initialized.
+        return false;
+    }
+
+    CAVE_ASSERT(entry_function != nullptr);
+
+    //
+    // The whole stack is committed upfront, so that the fiber never has to grow its stack while running.
+    // NOTE: On x64 there is a single calling convention, so the entry function can be passed directly as the start routine.
+    //
+    m_context = CreateFiberEx(
+        stack_byte_count,
+        stack_byte_count,
+        FIBER_FLAG_FLOAT_SWITCH,
+        reinterpret_cast<LPFIBER_START_ROUTINE>(entry_function),
+        user_data
+    );
+    if (!m_context)
+        return false;
+
+    m_is_initialized = true;
+    m_is_thread_fiber = false;
+    return true;
+}
+
+bool Fiber::initialize_from_current_thread()
+{
+    if (m_is_initialized)
+    {
+        // The fiber has already been initialized.
+        return false;
+    }
+
+    m_context = ConvertThreadToFiberEx(nullptr, FIBER_FLAG_FLOAT_SWITCH);
+    if (!m_context)
+        return false;
+
+    m_is_initialized = true;
+    m_is_thread_fiber = true;
+    return true;
+}
+
+void Fiber::shutdown()
+{
+    if (!m_is_initialized)
+    {
+        // The fiber has already been shut down.
+        return;
+    }
+
+    if (m_is_thread_fiber)
+        ConvertFiberToThread();
+    else
+        DeleteFiber(m_context);
+
+    m_context = nullptr;
+    m_is_initialized = false;
+    m_is_thread_fiber = false;
+}
+
+void Fiber::switch_to(Fiber& target)
+{
+    CAVE_ASSERT(m_is_initialized && target.m_is_initialized);
+    CAVE_ASSERT(this != &target);
+    SwitchToFiber(target.m_context);
+}
+
+} // namespace CaveGame
+
+#endif // CAVE_PLATFORM_WINDOWS
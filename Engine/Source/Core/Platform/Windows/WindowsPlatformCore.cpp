@@ -6,13 +6,35 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
-#include <Core/Assertion.h>
-#include <Core/Platform/PlatformCore.h>
-#include <Core/Platform/Windows/WindowsGuardedInclude.h>
+#include <Core/CoreDefines.h>
+#if CAVE_PLATFORM_WINDOWS
+
+    #include <Core/Assertion.h>
+    #include <Core/Platform/PlatformCore.h>
+    #include <Core/Platform/Windows/WindowsGuardedInclude.h>
+    #include <immintrin.h>
+    #include <timeapi.h>
 
 namespace CaveGame
 {
 
+bool PlatformCore::initialize()
+{
+    // Query the performance counter frequency, such that the value is cached before any timer is used.
+    const u64 tick_counter_frequency = get_tick_counter_frequency();
+    if (tick_counter_frequency == 0)
+        return false;
+
+    // Request a 1ms scheduler granularity, otherwise `Sleep` can oversleep by up to ~15.6ms.
+    timeBeginPeriod(1);
+    return true;
+}
+
+void PlatformCore::shutdown()
+{
+    timeEndPeriod(1);
+}
+
 u64 PlatformCore::get_current_tick_counter()
 {
     LARGE_INTEGER tick_counter;
@@ -51,4 +73,73 @@ u64 PlatformCore::get_tick_counter_frequency()
     return s_tick_counter_frequency;
 }
 
+void PlatformCore::sleep_for_microseconds(u64 microseconds)
+{
+    // NOTE: `Sleep` only has a millisecond resolution, so the duration is rounded down.
+    const DWORD milliseconds = static_cast<DWORD>(microseconds / 1000);
+    Sleep(milliseconds);
+}
+
+void PlatformCore::pause_processor()
+{
+    _mm_pause();
+}
+
+usize PlatformCore::get_virtual_memory_page_size()
+{
+    static usize s_page_size = 0;
+    if (s_page_size == 0)
+    {
+        SYSTEM_INFO system_info;
+        GetSystemInfo(&system_info);
+        s_page_size = system_info.dwPageSize;
+    }
+
+    return s_page_size;
+}
+
+usize PlatformCore::get_large_page_size()
+{
+    // NOTE: Large pages can't be used for ranges that are committed incrementally (see `advise_large_pages`), so they
+    // are reported as unsupported. Otherwise, the arenas would over-reserve and align their ranges for nothing.
+    return 0;
+}
+
+void* PlatformCore::reserve_virtual_memory(usize byte_count)
+{
+    return VirtualAlloc(nullptr, byte_count, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool PlatformCore::commit_virtual_memory(void* address, usize byte_count)
+{
+    CAVE_ASSERT((reinterpret_cast<uintptr>(address) % get_virtual_memory_page_size()) == 0);
+    return (VirtualAlloc(address, byte_count, MEM_COMMIT, PAGE_READWRITE) != nullptr);
+}
+
+void PlatformCore::decommit_virtual_memory(void* address, usize byte_count)
+{
+    CAVE_ASSERT((reinterpret_cast<uintptr>(address) % get_virtual_memory_page_size()) == 0);
+    MAYBE_UNUSED const BOOL result = VirtualFree(address, byte_count, MEM_DECOMMIT);
+    CAVE_ASSERT(result);
+}
+
+bool PlatformCore::advise_large_pages(MAYBE_UNUSED void* address, MAYBE_UNUSED usize byte_count)
+{
+    // NOTE: On Windows, large pages must be reserved and committed at once (using `MEM_LARGE_PAGES`) and require the
+    // "Lock pages in memory" privilege, so they can't be used for ranges that are committed incrementally.
+    return false;
+}
+
+void PlatformCore::release_virtual_memory(void* address, usize byte_count)
+{
+    if (address == nullptr)
+        return;
+
+    // NOTE: When releasing a region, `VirtualFree` requires the size to be zero.
+    MAYBE_UNUSED const BOOL result = VirtualFree(address, 0, MEM_RELEASE);
+    CAVE_ASSERT(result);
+}
+
 } // namespace CaveGame
+
+#endif // CAVE_PLATFORM_WINDOWS
@@ -49,7 +49,7 @@ static void win32_register_window_class()
     }
 }
 
-bool Window::initialize()
+bool Window::native_initialize()
 {
     if (m_native_handle != nullptr)
     {
@@ -79,7 +79,7 @@ bool Window::initialize()
     return m_native_handle != nullptr;
 }
 
-void Window::shutdown()
+void Window::native_shutdown()
 {
     if (m_native_handle == nullptr)
     {
@@ -91,7 +91,7 @@ void Window::shutdown()
     m_native_handle = nullptr;
 }
 
-void Window::process_event_queue()
+void Window::native_process_event_queue()
 {
     CAVE_ASSERT(m_native_handle != nullptr);
 
@@ -103,14 +103,14 @@ void Window::process_event_queue()
     }
 }
 
-u32 Window::get_client_area_width() const
+u32 Window::native_get_client_area_width() const
 {
     RECT client_rect;
     GetClientRect(static_cast<HWND>(m_native_handle), &client_rect);
     return client_rect.right - client_rect.left;
 }
 
-u32 Window::get_client_area_height() const
+u32 Window::native_get_client_area_height() const
 {
     RECT client_rect;
     GetClientRect(static_cast<HWND>(m_native_handle), &client_rect);
@@ -6,6 +6,9 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <Core/Jobs/JobSystem.h>
+#include <Core/Memory/FrameAllocator.h>
+#include <Core/Platform/PlatformCore.h>
 #include <Core/Platform/Timer.h>
 #include <Engine/Engine.h>
 
@@ -14,12 +17,15 @@ namespace CaveGame
 
 struct EngineData
 {
+    EngineDescription description;
     Window window;
+    FramePacer frame_pacer;
+    FrameTaskGraph frame_task_graph;
 };
 
 static EngineData* s_engine;
 
-bool Engine::initialize()
+bool Engine::initialize(const EngineDescription& description)
 {
     if (s_engine)
     {
@@ -29,14 +35,17 @@ bool Engine::initialize()
 
     // Allocate the memory for the engine structure.
     s_engine = new EngineData();
+    s_engine->description = description;
 
-    if (!s_engine->window.initialize())
+    if (!s_engine->window.initialize(description.window))
     {
         // NOTE: If the window creation fails there is no point in continuing the program execution.
-        // Without a window, the game is definetely unplayable.
+        // Without a window, the game is definetely unplayable. When no display is available, the
+        // engine should be initialized with a headless window instead.
         return false;
     }
 
+    s_engine->frame_pacer.initialize(description.target_frame_rate, description.frame_limiter_spin_threshold);
     return true;
 }
 
@@ -66,10 +75,20 @@ void Engine::run(GameLoop& game_loop)
     // Running the update function with a delta time of 0 might cause errors.
     float last_frame_delta_time = 1.0F / 60.0F;
 
+    const float fixed_update_step = s_engine->description.fixed_update_step;
+    const u32 max_fixed_updates_per_frame = s_engine->description.max_fixed_updates_per_frame;
+    const bool is_fixed_update_enabled = (fixed_update_step > 0.0F);
+
+    // The simulation time that has not been consumed by the fixed update steps yet.
+    float fixed_update_accumulator = 0.0F;
+
     while (game_loop.is_running())
     {
         Timer frame_timer;
 
+        // Release the scratch memory allocated two frames ago.
+        FrameAllocator::begin_frame();
+
         s_engine->window.process_event_queue();
         if (s_engine->window.should_close())
         {
@@ -78,6 +97,36 @@ void Engine::run(GameLoop& game_loop)
         }
 
         game_loop.on_game_update(last_frame_delta_time);
+        s_engine->frame_task_graph.execute(last_frame_delta_time);
+
+        float interpolation_alpha = 1.0F;
+        if (is_fixed_update_enabled)
+        {
+            fixed_update_accumulator += last_frame_delta_time;
+
+            u32 fixed_update_count = 0;
+            while (fixed_update_accumulator >= fixed_update_step && fixed_update_count < max_fixed_updates_per_frame)
+            {
+                game_loop.on_game_fixed_update(fixed_update_step);
+                fixed_update_accumulator -= fixed_update_step;
+                ++fixed_update_count;
+            }
+
+            if (fixed_update_accumulator >= fixed_update_step)
+            {
+                // The catch-up limit has been reached. Drop the whole steps that couldn't be simulated this frame,
+                // but keep the fractional part such that the interpolation remains continuous.
+                const float dropped_step_count = static_cast<float>(static_cast<u64>(fixed_update_accumulator / fixed_update_step));
+                fixed_update_accumulator -= dropped_step_count * fixed_update_step;
+            }
+
+            interpolation_alpha = fixed_update_accumulator / fixed_update_step;
+        }
+
+        game_loop.on_game_render(interpolation_alpha);
+
+        // Block until the next frame should start. This is a no-op if the frame rate is not limited.
+        s_engine->frame_pacer.wait_for_next_frame();
         last_frame_delta_time = frame_timer.stop_and_get_elapsed_seconds();
     }
 
@@ -90,12 +139,48 @@ Window& Engine::get_window()
     return s_engine->window;
 }
 
+const FramePacingStatistics& Engine::get_frame_pacing_statistics()
+{
+    CAVE_ASSERT(s_engine);
+    return s_engine->frame_pacer.get_statistics();
+}
+
+FrameTaskGraph& Engine::get_frame_task_graph()
+{
+    CAVE_ASSERT(s_engine);
+    return s_engine->frame_task_graph;
+}
+
 bool initialize_core_systems()
 {
+    if (!PlatformCore::initialize())
+    {
+        // NOTE: Without the platform layer no timing information is available, and thus the
+        // game loop can't be executed.
+        return false;
+    }
+
+    if (!FrameAllocator::initialize())
+    {
+        // NOTE: The frame allocator only reserves address space, so this can only fail if the
+        // address space is exhausted.
+        return false;
+    }
+
+    if (!JobSystem::initialize())
+    {
+        // NOTE: The job system can only fail to initialize if it has already been initialized.
+        return false;
+    }
+
     return true;
 }
 
 void shutdown_core_systems()
-{}
+{
+    JobSystem::shutdown();
+    FrameAllocator::shutdown();
+    PlatformCore::shutdown();
+}
 
 } // namespace CaveGame
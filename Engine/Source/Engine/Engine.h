@@ -9,15 +9,45 @@
 #pragma once
 
 #include <Core/Platform/Window.h>
+#include <Engine/FramePacer.h>
+#include <Engine/FrameTaskGraph.h>
 #include <Engine/GameLoop.h>
 
 namespace CaveGame
 {
 
+struct EngineDescription
+{
+    WindowDescription window;
+
+    //
+    // The duration, measured in seconds, of a fixed simulation step. When greater than zero, the engine
+    // accumulates the frame time and invokes `GameLoop::on_game_fixed_update` once for every whole step.
+    // When zero, the fixed-step simulation is disabled and only the variable-rate update is invoked.
+    //
+    float fixed_update_step { 0.0F };
+
+    //
+    // The maximum number of fixed simulation steps executed during a single frame. If a frame takes long enough
+    // to require more steps, the excess simulation time is dropped. This prevents a slow frame from requiring
+    // even more simulation work in the next frame (the so called "spiral of death").
+    //
+    u32 max_fixed_updates_per_frame { 8 };
+
+    // The maximum number of frames produced per second. Zero means that the frame rate is not limited.
+    float target_frame_rate { 0.0F };
+
+    //
+    // How close to the frame deadline, measured in seconds, the frame limiter stops sleeping and starts spinning.
+    // Larger values give more precise frame pacing, at the cost of more CPU time spent busy-waiting.
+    //
+    float frame_limiter_spin_threshold { 0.002F };
+};
+
 class Engine
 {
 public:
-    static bool initialize();
+    static bool initialize(const EngineDescription& description);
     static void shutdown();
 
     template<typename GameLoopType>
@@ -34,6 +64,18 @@ public:
     //
     NODISCARD static Window& get_window();
 
+    //
+    // Returns the timing statistics measured by the frame limiter.
+    // If the frame rate is not limited, no statistics are gathered.
+    //
+    NODISCARD static const FramePacingStatistics& get_frame_pacing_statistics();
+
+    //
+    // Returns the task graph executed every frame, right after `GameLoop::on_game_update`. The game systems register
+    // their per-frame stages in it, usually in `GameLoop::on_game_start`.
+    //
+    NODISCARD static FrameTaskGraph& get_frame_task_graph();
+
 private:
     static void run(GameLoop& game_loop);
 };
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Assertion.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Platform/PlatformCore.h>
+#include <Engine/FramePacer.h>
+
+namespace CaveGame
+{
+
+void FramePacer::initialize(float target_frame_rate, float spin_threshold)
+{
+    m_statistics = {};
+    m_total_jitter = 0.0;
+
+    if (target_frame_rate <= 0.0F)
+    {
+        // The frame pacer is disabled.
+        m_frame_duration_ticks = 0;
+        return;
+    }
+
+    const double tick_frequency = static_cast<double>(PlatformCore::get_tick_counter_frequency());
+    m_frame_duration_ticks = static_cast<u64>(tick_frequency / static_cast<double>(target_frame_rate));
+    m_spin_threshold_ticks = static_cast<u64>(tick_frequency * static_cast<double>(Math::max(spin_threshold, 0.0F)));
+    m_next_frame_deadline = PlatformCore::get_current_tick_counter() + m_frame_duration_ticks;
+}
+
+void FramePacer::wait_for_next_frame()
+{
+    if (!is_enabled())
+        return;
+
+    const u64 tick_frequency = PlatformCore::get_tick_counter_frequency();
+    u64 current_tick = PlatformCore::get_current_tick_counter();
+
+    if (current_tick >= m_next_frame_deadline)
+    {
+        // The frame took longer than the target duration. Instead of producing the following frames as fast as
+        // possible in order to catch up, restart the pacing from the current moment.
+        ++m_statistics.missed_deadline_count;
+        m_next_frame_deadline = current_tick + m_frame_duration_ticks;
+        return;
+    }
+
+    // Sleep phase. The thread is suspended until it is close enough to the deadline.
+    const u64 remaining_ticks = m_next_frame_deadline - current_tick;
+    if (remaining_ticks > m_spin_threshold_ticks)
+    {
+        const u64 sleep_ticks = remaining_ticks - m_spin_threshold_ticks;
+        const u64 sleep_microseconds = (sleep_ticks * 1000000) / tick_frequency;
+        if (sleep_microseconds > 0)
+            PlatformCore::sleep_for_microseconds(sleep_microseconds);
+    }
+
+    // Spin phase. The remaining time is spent busy-waiting on the tick counter.
+    current_tick = PlatformCore::get_current_tick_counter();
+    while (current_tick < m_next_frame_deadline)
+    {
+        PlatformCore::pause_processor();
+        current_tick = PlatformCore::get_current_tick_counter();
+    }
+
+    const float jitter = static_cast<float>(current_tick - m_next_frame_deadline) / static_cast<float>(tick_frequency);
+    ++m_statistics.paced_frame_count;
+    m_statistics.last_jitter = jitter;
+    m_statistics.max_jitter = Math::max(m_statistics.max_jitter, jitter);
+    m_total_jitter += static_cast<double>(jitter);
+    m_statistics.average_jitter = static_cast<float>(m_total_jitter / static_cast<double>(m_statistics.paced_frame_count));
+
+    // NOTE: The next deadline is computed relative to the previous deadline (and not to the current moment),
+    // such that the jitter doesn't accumulate over time.
+    m_next_frame_deadline += m_frame_duration_ticks;
+}
+
+} // namespace CaveGame
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+//
+// Timing statistics gathered by the frame pacer. The jitter of a frame is the amount of time between
+// its deadline and the moment the wait actually finished. All values are measured in seconds.
+//
+struct FramePacingStatistics
+{
+    float last_jitter { 0.0F };
+    float max_jitter { 0.0F };
+    float average_jitter { 0.0F };
+
+    // The number of frames that were paced (that didn't miss their deadline).
+    u64 paced_frame_count { 0 };
+
+    // The number of frames that took longer than the target frame duration, so no wait was performed.
+    u64 missed_deadline_count { 0 };
+};
+
+//
+// Limits the rate at which frames are produced to a target frame rate.
+//
+// Waiting for the next frame deadline is done in two phases. First, the thread sleeps (freeing the core)
+// until it is `spin_threshold` seconds away from the deadline. Then, the remaining time is spent spinning on the
+// tick counter, as the scheduler can't wake up the thread precisely enough.
+//
+class FramePacer
+{
+public:
+    //
+    // Sets the target frame rate, in frames per second. A target frame rate of zero disables the frame pacer.
+    // The `spin_threshold` should be slightly larger than the worst-case oversleep of the platform scheduler.
+    //
+    void initialize(float target_frame_rate, float spin_threshold);
+
+    NODISCARD ALWAYS_INLINE bool is_enabled() const { return (m_frame_duration_ticks > 0); }
+
+    //
+    // Blocks the calling thread until the deadline of the current frame is reached.
+    // If the deadline has already been missed, the function returns immediately and the pacing restarts from now.
+    //
+    void wait_for_next_frame();
+
+    NODISCARD ALWAYS_INLINE const FramePacingStatistics& get_statistics() const { return m_statistics; }
+    ALWAYS_INLINE void reset_statistics()
+    {
+        m_statistics = {};
+        m_total_jitter = 0.0;
+    }
+
+private:
+    u64 m_frame_duration_ticks { 0 };
+    u64 m_spin_threshold_ticks { 0 };
+    u64 m_next_frame_deadline { 0 };
+
+    FramePacingStatistics m_statistics;
+    double m_total_jitter { 0.0 };
+};
+
+} // namespace CaveGame
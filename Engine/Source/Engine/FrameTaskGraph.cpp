@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Assertion.h>
+#include <Core/Containers/HashMap.h>
+#include <Core/Jobs/JobSystem.h>
+#include <Core/Memory/FrameAllocator.h>
+#include <Core/Platform/PlatformCore.h>
+#include <Engine/FrameTaskGraph.h>
+
+namespace CaveGame
+{
+
+static constexpr u32 invalid_stage_index = static_cast<u32>(-1);
+
+//
+// The state of a single graph execution. The arrays are allocated from the frame allocator and are indexed by the
+// stage index.
+//
+struct FrameTaskGraph::FrameExecution
+{
+    float delta_time;
+    JobCounter counter;
+
+    // The number of dependencies of each stage that haven't finished executing yet.
+    std::atomic<u32>* remaining_dependency_counts;
+
+    u64* stage_begin_ticks;
+    u64* stage_end_ticks;
+};
+
+// The stages that accessed a resource since it was last written, used to derive the dependencies while compiling.
+struct ResourceAccessState
+{
+    u32 last_writer_stage_index { invalid_stage_index };
+    Vector<u32> reader_stage_indices;
+};
+
+// Adds the dependency to the list, unless it is already present or refers to no stage.
+static void add_dependency(Vector<u32>& dependencies, u32 stage_index)
+{
+    if (stage_index == invalid_stage_index)
+        return;
+
+    for (u32 dependency : dependencies)
+    {
+        if (dependency == stage_index)
+            return;
+    }
+
+    dependencies.add(stage_index);
+}
+
+FrameStageHandle FrameTaskGraph::register_stage(const FrameStageDescription& description)
+{
+    CAVE_ASSERT(description.function != nullptr);
+
+    Stage stage = {};
+    stage.handle = m_next_stage_handle++;
+    stage.name = description.name;
+    stage.function = description.function;
+    stage.user_data = description.user_data;
+    stage.read_resources = description.read_resources;
+    stage.write_resources = description.write_resources;
+    m_stages.add(move(stage));
+
+    ++m_registered_stage_count;
+    m_is_schedule_dirty = true;
+    return m_stages.last().handle;
+}
+
+void FrameTaskGraph::unregister_stage(FrameStageHandle stage_handle)
+{
+    for (Stage& stage : m_stages)
+    {
+        if (stage.handle == stage_handle && stage.function)
+        {
+            // The stage is only removed from the list when the schedule is compiled again.
+            stage.function = nullptr;
+            --m_registered_stage_count;
+            m_is_schedule_dirty = true;
+            return;
+        }
+    }
+
+    // The stage has never been registered or has already been unregistered.
+    CAVE_ASSERT(false);
+}
+
+void FrameTaskGraph::compile_schedule()
+{
+    // Remove the unregistered stages, while preserving the registration order of the remaining ones.
+    if (m_registered_stage_count != m_stages.count())
+    {
+        Vector<Stage> registered_stages;
+        registered_stages.ensure_capacity(m_registered_stage_count);
+        for (Stage& stage : m_stages)
+        {
+            if (stage.function)
+                registered_stages.add(move(stage));
+        }
+        m_stages = move(registered_stages);
+    }
+
+    const u32 stage_count = static_cast<u32>(m_stages.count());
+
+    //
+    // Walk the stages in registration order, tracking for each resource the last stage that wrote it and the stages
+    // that read it since then. A stage that reads a resource depends on its last writer, while a stage that writes
+    // a resource depends on its last writer and on all its readers. The dependencies on earlier stages are implied.
+    //
+    HashMap<Name, ResourceAccessState> resource_states;
+    Vector<Vector<u32>> stage_dependencies;
+    stage_dependencies.set_count_defaulted(stage_count);
+
+    for (u32 stage_index = 0; stage_index < stage_count; ++stage_index)
+    {
+        const Stage& stage = m_stages[stage_index];
+        Vector<u32>& dependencies = stage_dependencies[stage_index];
+
+        for (Name resource : stage.read_resources)
+        {
+            ResourceAccessState& resource_state = resource_states.get_or_add(resource);
+            add_dependency(dependencies, resource_state.last_writer_stage_index);
+        }
+
+        for (Name resource : stage.write_resources)
+        {
+            ResourceAccessState& resource_state = resource_states.get_or_add(resource);
+            add_dependency(dependencies, resource_state.last_writer_stage_index);
+            for (u32 reader_stage_index : resource_state.reader_stage_indices)
+            {
+                if (reader_stage_index != stage_index)
+                    add_dependency(dependencies, reader_stage_index);
+            }
+        }
+
+        // NOTE: The accesses are recorded after all dependencies have been added, so a stage that both reads and writes
+        // the same resource doesn't depend on itself.
+        for (Name resource : stage.read_resources)
+            resource_states.get_or_add(resource).reader_stage_indices.add(stage_index);
+
+        for (Name resource : stage.write_resources)
+        {
+            ResourceAccessState& resource_state = resource_states.get_or_add(resource);
+            resource_state.last_writer_stage_index = stage_index;
+            resource_state.reader_stage_indices.clear();
+        }
+    }
+
+    // Invert the dependency lists, as the stages are started by the completion of their dependencies.
+    m_dependency_counts.clear();
+    m_successor_offsets.clear();
+    m_successors.clear();
+    m_root_stages.clear();
+    m_dependency_counts.set_count(stage_count, 0);
+    m_successor_offsets.set_count(stage_count + 1, 0);
+
+    for (u32 stage_index = 0; stage_index < stage_count; ++stage_index)
+    {
+        m_dependency_counts[stage_index] = static_cast<u32>(stage_dependencies[stage_index].count());
+        for (u32 dependency : stage_dependencies[stage_index])
+            ++m_successor_offsets[dependency + 1];
+
+        if (m_dependency_counts[stage_index] == 0)
+            m_root_stages.add(stage_index);
+    }
+
+    for (u32 stage_index = 0; stage_index < stage_count; ++stage_index)
+        m_successor_offsets[stage_index + 1] += m_successor_offsets[stage_index];
+
+    Vector<u32> successor_write_offsets = m_successor_offsets;
+    m_successors.set_count(m_successor_offsets[stage_count], 0);
+    for (u32 stage_index = 0; stage_index < stage_count; ++stage_index)
+    {
+        for (u32 dependency : stage_dependencies[stage_index])
+            m_successors[successor_write_offsets[dependency]++] = stage_index;
+    }
+
+    // Reserve the memory for the critical path, such that updating the statistics never allocates.
+    m_critical_path.clear();
+    m_critical_path.ensure_capacity(stage_count);
+
+    m_is_schedule_dirty = false;
+    ++m_statistics.compiled_schedule_count;
+}
+
+void FrameTaskGraph::execute(float delta_time)
+{
+    if (m_is_schedule_dirty)
+        compile_schedule();
+
+    const u32 stage_count = static_cast<u32>(m_stages.count());
+    if (stage_count == 0)
+    {
+        const u64 compiled_schedule_count = m_statistics.compiled_schedule_count;
+        m_statistics = {};
+        m_statistics.compiled_schedule_count = compiled_schedule_count;
+        m_critical_path.clear();
+        return;
+    }
+
+    FrameExecution execution;
+    execution.delta_time = delta_time;
+    execution.remaining_dependency_counts = FrameAllocator::allocate_array<std::atomic<u32>>(stage_count);
+    execution.stage_begin_ticks = FrameAllocator::allocate_array<u64>(stage_count);
+    execution.stage_end_ticks = FrameAllocator::allocate_array<u64>(stage_count);
+    for (u32 stage_index = 0; stage_index < stage_count; ++stage_index)
+        ::new (&execution.remaining_dependency_counts[stage_index]) std::atomic<u32>(m_dependency_counts[stage_index]);
+
+    const u64 frame_begin_tick = PlatformCore::get_current_tick_counter();
+    for (u32 stage_index : m_root_stages)
+        schedule_stage(&execution, stage_index);
+
+    JobSystem::wait_for_counter(execution.counter);
+    const u64 frame_end_tick = PlatformCore::get_current_tick_counter();
+
+    update_statistics(execution, frame_begin_tick, frame_end_tick);
+}
+
+void FrameTaskGraph::schedule_stage(FrameExecution* execution, u32 stage_index)
+{
+    JobSystem::schedule([this, execution, stage_index]() { execute_stage(execution, stage_index); }, &execution->counter);
+}
+
+void FrameTaskGraph::execute_stage(FrameExecution* execution, u32 stage_index)
+{
+    while (stage_index != invalid_stage_index)
+    {
+        const Stage& stage = m_stages[stage_index];
+        execution->stage_begin_ticks[stage_index] = PlatformCore::get_current_tick_counter();
+        stage.function(stage.user_data, execution->delta_time);
+        execution->stage_end_ticks[stage_index] = PlatformCore::get_current_tick_counter();
+
+        //
+        // The last successor that becomes ready is executed directly by this job, which saves the scheduling cost for
+        // the chains of stages that depend on each other.
+        // NOTE: The acquire-release decrement ensures that the stage observes the writes of all its dependencies.
+        //
+        u32 next_stage_index = invalid_stage_index;
+        for (u32 successor_offset = m_successor_offsets[stage_index]; successor_offset < m_successor_offsets[stage_index + 1]; ++successor_offset)
+        {
+            const u32 successor_stage_index = m_successors[successor_offset];
+            if (execution->remaining_dependency_counts[successor_stage_index].fetch_sub(1, std::memory_order_acq_rel) != 1)
+                continue;
+
+            if (next_stage_index != invalid_stage_index)
+                schedule_stage(execution, next_stage_index);
+            next_stage_index = successor_stage_index;
+        }
+
+        stage_index = next_stage_index;
+    }
+}
+
+void FrameTaskGraph::update_statistics(const FrameExecution& execution, u64 frame_begin_tick, u64 frame_end_tick)
+{
+    const u32 stage_count = static_cast<u32>(m_stages.count());
+    const float tick_frequency = static_cast<float>(PlatformCore::get_tick_counter_frequency());
+
+    //
+    // The stages are stored in a valid execution order, so the longest path that ends with each stage can be computed
+    // in a single pass, by propagating the path durations from each stage to its successors.
+    //
+    u64* path_ticks = FrameAllocator::allocate_array<u64>(stage_count);
+    u32* critical_predecessors = FrameAllocator::allocate_array<u32>(stage_count);
+    for (u32 stage_index = 0; stage_index < stage_count; ++stage_index)
+    {
+        path_ticks[stage_index] = 0;
+        critical_predecessors[stage_index] = invalid_stage_index;
+    }
+
+    u64 total_stage_ticks = 0;
+    u32 critical_path_last_stage_index = 0;
+    for (u32 stage_index = 0; stage_index < stage_count; ++stage_index)
+    {
+        const u64 stage_ticks = execution.stage_end_ticks[stage_index] - execution.stage_begin_ticks[stage_index];
+        total_stage_ticks += stage_ticks;
+
+        // Before this point, the path duration only accounts for the longest path of the dependencies.
+        path_ticks[stage_index] += stage_ticks;
+        if (path_ticks[stage_index] > path_ticks[critical_path_last_stage_index])
+            critical_path_last_stage_index = stage_index;
+
+        for (u32 successor_offset = m_successor_offsets[stage_index]; successor_offset < m_successor_offsets[stage_index + 1]; ++successor_offset)
+        {
+            const u32 successor_stage_index = m_successors[successor_offset];
+            if (path_ticks[stage_index] >= path_ticks[successor_stage_index])
+            {
+                path_ticks[successor_stage_index] = path_ticks[stage_index];
+                critical_predecessors[successor_stage_index] = stage_index;
+            }
+        }
+    }
+
+    m_statistics.frame_seconds = static_cast<float>(frame_end_tick - frame_begin_tick) / tick_frequency;
+    m_statistics.total_stage_seconds = static_cast<float>(total_stage_ticks) / tick_frequency;
+    m_statistics.critical_path_seconds = static_cast<float>(path_ticks[critical_path_last_stage_index]) / tick_frequency;
+    m_statistics.stage_count = stage_count;
+
+    // Walk the critical path backwards and reverse it, such that the stages are listed in execution order.
+    m_critical_path.clear();
+    for (u32 stage_index = critical_path_last_stage_index; stage_index != invalid_stage_index; stage_index = critical_predecessors[stage_index])
+        m_critical_path.add(m_stages[stage_index].name);
+
+    const usize critical_path_stage_count = m_critical_path.count();
+    for (usize index = 0; index < critical_path_stage_count / 2; ++index)
+    {
+        const Name name = m_critical_path[index];
+        m_critical_path[index] = m_critical_path[critical_path_stage_count - index - 1];
+        m_critical_path[critical_path_stage_count - index - 1] = name;
+    }
+
+    m_statistics.critical_path_stage_count = static_cast<u32>(critical_path_stage_count);
+}
+
+} // namespace CaveGame
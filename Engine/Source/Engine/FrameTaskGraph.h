@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Catalin Ionescu 2024. All rights reserved.
+ * Copyright (c) Robert Bengulescu 2024. All rights reserved.
+ * Copyright (c) Traian Avram 2024. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/Name.h>
+#include <Core/Containers/Vector.h>
+#include <Core/CoreTypes.h>
+
+namespace CaveGame
+{
+
+using FrameStageFunction = void (*)(void* user_data, float delta_time);
+
+// Identifies a registered stage. Zero is never a valid handle.
+using FrameStageHandle = u32;
+static constexpr FrameStageHandle invalid_frame_stage_handle = 0;
+
+struct FrameStageDescription
+{
+    // Used to identify the stage in the timing statistics.
+    Name name;
+
+    FrameStageFunction function { nullptr };
+    void* user_data { nullptr };
+
+    //
+    // The resources accessed by the stage. A resource is any piece of state shared between stages (for example the
+    // "World", "Lighting" or "Meshes"), identified by its name. A stage that writes a resource must not run at the same
+    // time as any other stage that reads or writes it, while any number of stages can read a resource at the same time.
+    //
+    Vector<Name> read_resources;
+    Vector<Name> write_resources;
+};
+
+//
+// Timing statistics of the last executed frame. All values are measured in seconds.
+//
+struct FrameTaskGraphStatistics
+{
+    // The time between the moment the first stage started and the moment the last stage finished executing.
+    float frame_seconds { 0.0F };
+
+    // The sum of the durations of all stages, which is how long the frame would have taken on a single thread.
+    float total_stage_seconds { 0.0F };
+
+    //
+    // The duration of the longest chain of dependent stages. No matter how many threads are available, the frame can't
+    // be faster than its critical path, so shortening the stages on it is the only way to make the frame faster.
+    //
+    float critical_path_seconds { 0.0F };
+
+    u32 stage_count { 0 };
+    u32 critical_path_stage_count { 0 };
+
+    // The number of times the schedule has been compiled, which only happens after the registered stages change.
+    u64 compiled_schedule_count { 0 };
+};
+
+//
+// Executes the per-frame stages registered by the game systems, in parallel, on the job system threads.
+//
+// The dependencies between the stages are derived from the resources they access and from their registration order:
+// a stage depends on the previously registered stages that write a resource it accesses, and on the previously
+// registered stages that read a resource it writes. The stages that don't conflict run in parallel, while the
+// conflicting ones always run in their registration order, so the result of a frame doesn't depend on the scheduling.
+//
+// The dependency graph is compiled into a schedule the first time the graph is executed after a stage has been
+// registered or unregistered, so executing the graph doesn't allocate memory from the heap.
+//
+// NOTE: Stages must be registered, unregistered and executed from the main thread, and never while the graph executes.
+//
+class FrameTaskGraph
+{
+    CAVE_MAKE_NONCOPYABLE(FrameTaskGraph);
+    CAVE_MAKE_NONMOVABLE(FrameTaskGraph);
+
+public:
+    FrameTaskGraph() = default;
+
+    NODISCARD FrameStageHandle register_stage(const FrameStageDescription& description);
+    void unregister_stage(FrameStageHandle stage_handle);
+
+    NODISCARD ALWAYS_INLINE u32 get_stage_count() const { return m_registered_stage_count; }
+
+    //
+    // Executes all registered stages and blocks until they have finished executing. The calling thread executes
+    // stages (and other jobs) while waiting. Compiles the schedule first, if the registered stages have changed.
+    //
+    void execute(float delta_time);
+
+public:
+    NODISCARD ALWAYS_INLINE const FrameTaskGraphStatistics& get_statistics() const { return m_statistics; }
+
+    // Returns the names of the stages on the critical path of the last executed frame, in execution order.
+    NODISCARD ALWAYS_INLINE const Vector<Name>& get_critical_path() const { return m_critical_path; }
+
+private:
+    struct Stage
+    {
+        FrameStageHandle handle;
+        Name name;
+        FrameStageFunction function;
+        void* user_data;
+        Vector<Name> read_resources;
+        Vector<Name> write_resources;
+    };
+
+    struct FrameExecution;
+
+    // Removes the unregistered stages and builds the dependency graph of the remaining ones.
+    void compile_schedule();
+
+    void schedule_stage(FrameExecution* execution, u32 stage_index);
+
+    // Executes the stage and then the stages that became ready, scheduling all but one of them as separate jobs.
+    void execute_stage(FrameExecution* execution, u32 stage_index);
+
+    void update_statistics(const FrameExecution& execution, u64 frame_begin_tick, u64 frame_end_tick);
+
+private:
+    // The stages in registration order, which is always a valid execution order. Unregistered stages have a null function.
+    Vector<Stage> m_stages;
+    u32 m_registered_stage_count { 0 };
+    FrameStageHandle m_next_stage_handle { 1 };
+    bool m_is_schedule_dirty { false };
+
+    //
+    // The compiled schedule. The stages that must wait for stage `i` are stored in `m_successors`, in the range starting
+    // at `m_successor_offsets[i]` and ending at `m_successor_offsets[i + 1]`.
+    //
+    Vector<u32> m_dependency_counts;
+    Vector<u32> m_successor_offsets;
+    Vector<u32> m_successors;
+    Vector<u32> m_root_stages;
+
+    FrameTaskGraphStatistics m_statistics;
+    Vector<Name> m_critical_path;
+};
+
+} // namespace CaveGame
@@ -20,8 +20,25 @@ public:
     
     virtual void on_game_end() {}
 
+    //
+    // Invoked once per frame, on the main thread. The per-frame work that can run in parallel should instead be
+    // registered as stages of the frame task graph (see `Engine::get_frame_task_graph`), which is executed right after.
+    //
     virtual void on_game_update(float delta_time) = 0;
 
+    //
+    // Invoked zero or more times per frame, each time advancing the simulation by exactly `fixed_delta_time` seconds.
+    // Only invoked when the engine runs with a fixed simulation step (see `EngineDescription::fixed_update_step`).
+    //
+    virtual void on_game_fixed_update(MAYBE_UNUSED float fixed_delta_time) {}
+
+    //
+    // Invoked once per frame, after all updates. The `interpolation_alpha` (in range [0, 1)) represents how far the
+    // current time is between the last two fixed simulation steps and should be used to blend between their states.
+    // When the fixed simulation step is disabled, the `interpolation_alpha` is always one.
+    //
+    virtual void on_game_render(MAYBE_UNUSED float interpolation_alpha) {}
+
 public:
     NODISCARD ALWAYS_INLINE bool is_running() const { return m_is_running; }
     ALWAYS_INLINE void stop_running() { m_is_running = false; }
@@ -0,0 +1,6 @@
+#!/bin/sh
+cd "$(dirname "$0")"
+
+# NOTE: Only the Windows premake binary is distributed with the repository. On Linux, premake5
+# must be installed and available in the PATH.
+premake5 --file="PremakeConfig.lua" gmake2
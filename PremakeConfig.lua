@@ -36,7 +36,8 @@ workspace "CaveGame"
 
     platforms
     {
-        "Windows"
+        "Windows",
+        "Linux"
     }
 
     filter "platforms:windows"
@@ -44,6 +45,11 @@ workspace "CaveGame"
         architecture "x64"
     filter {}
 
+    filter "platforms:linux"
+        system "linux"
+        architecture "x64"
+    filter {}
+
     startproject "CaveGame"
 
     project "Engine"
@@ -81,7 +87,17 @@ workspace "CaveGame"
             {
                 "d3d11.lib",
                 "d3dcompiler.lib",
-                "dxgi.lib"
+                "dxgi.lib",
+                "winmm.lib"
+            }
+        filter {}
+
+        filter "platforms:linux"
+            defines { "CAVE_PLATFORM_LINUX=1" }
+
+            links
+            {
+                "pthread"
             }
         filter {}
     -- endproject "Engine"
@@ -123,4 +139,61 @@ workspace "CaveGame"
             systemversion "latest"    
             defines { "CAVE_PLATFORM_WINDOWS=1" }
         filter {}
+
+        filter "platforms:linux"
+            defines { "CAVE_PLATFORM_LINUX=1" }
+
+            links
+            {
+                "pthread"
+            }
+        filter {}
     -- endproject "CaveGame"
+
+    project "Benchmarks"
+        kind "ConsoleApp"
+        location "%{wks.location}/Benchmarks"
+
+        language "c++"
+        cppdialect "c++20"
+
+        staticruntime "off"
+        exceptionhandling "off"
+        rtti "off"
+        characterset "unicode"
+
+        targetdir "%{wks.location}/Binaries/%{cfg.buildcfg}"
+        objdir "%{wks.location}/Intermediate"
+
+        files
+        {
+            "%{wks.location}/Benchmarks/**.cpp",
+            "%{wks.location}/Benchmarks/**.h"
+        }
+
+        includedirs
+        {
+            "%{wks.location}/Benchmarks",
+            "%{wks.location}/Engine/Source"
+        }
+
+        links
+        {
+            "Engine"
+        }
+
+        setup_project_configuration_settings()
+        filter "platforms:windows"
+            systemversion "latest"    
+            defines { "CAVE_PLATFORM_WINDOWS=1" }
+        filter {}
+
+        filter "platforms:linux"
+            defines { "CAVE_PLATFORM_LINUX=1" }
+
+            links
+            {
+                "pthread"
+            }
+        filter {}
+    -- endproject "Benchmarks"
@@ -8,11 +8,72 @@
 
 #include <CaveGameLoop.h>
 #include <Engine/Engine.h>
+#include <cstdlib>
+#include <cstring>
 
 namespace CaveGame
 {
 
-static int cave_game_main()
+//
+// Returns the value of the command line argument if it starts with the provided prefix, or nullptr otherwise.
+// For example, matching `-headless-frames=600` against `-headless-frames=` returns `600`.
+//
+static const char* match_command_line_argument(const char* argument, const char* prefix)
+{
+    const usize prefix_length = std::strlen(prefix);
+    if (std::strncmp(argument, prefix, prefix_length) != 0)
+        return nullptr;
+    return argument + prefix_length;
+}
+
+//
+// Supported command line arguments:
+//   -headless                  Runs the game without creating a native window.
+//   -headless-frames=<count>   Closes the headless window after the given number of frames.
+//   -headless-seconds=<count>  Closes the headless window after the given number of seconds.
+//   -fixed-update-rate=<hz>    Runs the simulation with a fixed step, at the given number of updates per second.
+//   -target-frame-rate=<hz>    Limits the number of frames produced per second.
+//
+static void parse_command_line(int argument_count, char** arguments, EngineDescription& description)
+{
+#if CAVE_PLATFORM_LINUX
+    // NOTE: There is no native windowing backend on Linux, so the game always runs headless.
+    description.window.mode = WindowMode::Headless;
+#endif // CAVE_PLATFORM_LINUX
+
+    for (int argument_index = 1; argument_index < argument_count; ++argument_index)
+    {
+        const char* argument = arguments[argument_index];
+        const char* value = nullptr;
+
+        if (std::strcmp(argument, "-headless") == 0)
+        {
+            description.window.mode = WindowMode::Headless;
+        }
+        else if ((value = match_command_line_argument(argument, "-headless-frames=")))
+        {
+            description.window.mode = WindowMode::Headless;
+            description.window.headless_close_after_frame_count = std::strtoull(value, nullptr, 10);
+        }
+        else if ((value = match_command_line_argument(argument, "-headless-seconds=")))
+        {
+            description.window.mode = WindowMode::Headless;
+            description.window.headless_close_after_seconds = std::strtof(value, nullptr);
+        }
+        else if ((value = match_command_line_argument(argument, "-fixed-update-rate=")))
+        {
+            const float fixed_update_rate = std::strtof(value, nullptr);
+            if (fixed_update_rate > 0.0F)
+                description.fixed_update_step = 1.0F / fixed_update_rate;
+        }
+        else if ((value = match_command_line_argument(argument, "-target-frame-rate=")))
+        {
+            description.target_frame_rate = std::strtof(value, nullptr);
+        }
+    }
+}
+
+static int cave_game_main(int argument_count, char** arguments)
 {
     if (!initialize_core_systems())
     {
@@ -20,8 +81,11 @@ static int cave_game_main()
         return 1;
     }
 
+    EngineDescription engine_description = {};
+    parse_command_line(argument_count, arguments, engine_description);
+
     Engine* engine = new Engine();
-    if (!engine->initialize())
+    if (!engine->initialize(engine_description))
     {
         // Engine initialize failed. Aborting.
         return 1;
@@ -39,8 +103,8 @@ static int cave_game_main()
 
 } // namespace CaveGame
 
-int main()
+int main(int argument_count, char** arguments)
 {
-    const int return_code = CaveGame::cave_game_main();
+    const int return_code = CaveGame::cave_game_main(argument_count, arguments);
     return return_code;
 }